@@ -0,0 +1,99 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Yutiyeff (https://github.com/Hapaxia/Yutiyeff)
+//
+// Copyright(c) 2023-2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace yutiyeff
+{
+
+// a string that keeps its text in one (canonical) encoding - that of the string type T (Utf8String, Utf16String or Utf32String) - and converts
+// it into each of the other encodings only when that encoding is asked for. each conversion is kept until the string is next changed so repeated
+// reads in any encoding are not converted again.
+// note that reading an encoding that has not been converted yet changes the string's cache so a string must not be read by several threads at once
+template <class T>
+class CachedString
+{
+public:
+	CachedString() = default;
+	template <class InT, class = typename std::enable_if<std::is_constructible<T, const InT&>::value>::type>
+	CachedString(const InT& text); // anything that T can be created from
+	CachedString(T&& string);
+
+	const T& getCanonical() const { return priv_canonical(); }
+	const Utf8String& getUtf8String() const { return priv_current(m_utf8String, m_isUtf8Current); }
+	const Utf16String& getUtf16String() const { return priv_current(m_utf16String, m_isUtf16Current); }
+	const Utf32String& getUtf32String() const { return priv_current(m_utf32String, m_isUtf32Current); }
+
+	std::string getString() const { return getUtf8String().getSequence(); } // get a standard std::string representing the UTF-8 formatted version of the string
+	std::size_t length() const { return getCanonical().length(); }
+	bool empty() const { return getCanonical().empty(); }
+	std::size_t size() const { return length(); }
+	char32_t operator[](const std::size_t index) const { return getCanonical()[index]; }
+	std::size_t find(const T& string, const std::size_t offset = 0u) const { return getCanonical().find(string, offset); }
+	T substr(const std::size_t length, const std::size_t offset = 0u) const { return getCanonical().substr(length, offset); }
+	auto getView() const -> decltype(std::declval<const T&>().getView()) { return getCanonical().getView(); }
+
+	// changes (to the canonical string) discard the other encodings
+	CachedString& operator+=(const T& string);
+	void insert(std::size_t offset, const T& string);
+	void insert(std::size_t offset, char32_t char32);
+	void erase(std::size_t startPos, std::size_t length = 0u);
+	void set(std::size_t index, char32_t char32);
+	void clear();
+
+private:
+	// each encoding has its own string. the one of type T is the canonical string, which is always current
+	mutable Utf8String m_utf8String;
+	mutable Utf16String m_utf16String;
+	mutable Utf32String m_utf32String;
+	mutable bool m_isUtf8Current{ std::is_same<T, Utf8String>::value };
+	mutable bool m_isUtf16Current{ std::is_same<T, Utf16String>::value };
+	mutable bool m_isUtf32Current{ std::is_same<T, Utf32String>::value };
+
+	Utf8String& priv_string(Utf8String*) const { return m_utf8String; }
+	Utf16String& priv_string(Utf16String*) const { return m_utf16String; }
+	Utf32String& priv_string(Utf32String*) const { return m_utf32String; }
+	T& priv_canonical() const { return priv_string(static_cast<T*>(nullptr)); }
+	template <class StringT>
+	const StringT& priv_current(StringT& string, bool& isCurrent) const;
+	T& priv_change(); // the canonical string to change (once the other encodings have been discarded)
+};
+
+using CachedUtf8String = CachedString<Utf8String>;
+using CachedUtf16String = CachedString<Utf16String>;
+using CachedUtf32String = CachedString<Utf32String>;
+
+} // namespace yutiyeff
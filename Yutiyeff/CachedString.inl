@@ -0,0 +1,125 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Yutiyeff (https://github.com/Hapaxia/Yutiyeff)
+//
+// Copyright(c) 2023-2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+
+#pragma once
+
+#include "CachedString.hpp"
+
+#include <functional>
+
+namespace yutiyeff
+{
+
+template <class T>
+template <class InT, class>
+inline CachedString<T>::CachedString(const InT& text)
+{
+	priv_canonical() = T(text);
+}
+
+template <class T>
+inline CachedString<T>::CachedString(T&& string)
+{
+	priv_canonical() = std::move(string);
+}
+
+template <class T>
+inline CachedString<T>& CachedString<T>::operator+=(const T& string)
+{
+	priv_change() += string;
+	return *this;
+}
+
+template <class T>
+inline void CachedString<T>::insert(const std::size_t offset, const T& string)
+{
+	priv_change().insert(offset, string);
+}
+
+template <class T>
+inline void CachedString<T>::insert(const std::size_t offset, const char32_t char32)
+{
+	priv_change().insert(offset, char32);
+}
+
+template <class T>
+inline void CachedString<T>::erase(const std::size_t startPos, const std::size_t length)
+{
+	priv_change().erase(startPos, length);
+}
+
+template <class T>
+inline void CachedString<T>::set(const std::size_t index, const char32_t char32)
+{
+	priv_change().set(index, char32);
+}
+
+template <class T>
+inline void CachedString<T>::clear()
+{
+	priv_change().clear();
+}
+
+template <class T>
+template <class StringT>
+inline const StringT& CachedString<T>::priv_current(StringT& string, bool& isCurrent) const
+{
+	if (!isCurrent)
+	{
+		const priv::StatsScope statsScope{ StatsOperation::Cache };
+		string = StringT(priv_canonical());
+		isCurrent = true;
+	}
+	return string;
+}
+
+template <class T>
+inline T& CachedString<T>::priv_change()
+{
+	// the other encodings are converted again when they are next read
+	m_isUtf8Current = std::is_same<T, Utf8String>::value;
+	m_isUtf16Current = std::is_same<T, Utf16String>::value;
+	m_isUtf32Current = std::is_same<T, Utf32String>::value;
+	return priv_canonical();
+}
+
+} // namespace yutiyeff
+
+namespace std
+{
+
+template <class T>
+struct hash<yutiyeff::CachedString<T>>
+{
+	std::size_t operator()(const yutiyeff::CachedString<T>& string) const { return hash<T>{}(string.getCanonical()); }
+};
+
+} // namespace std
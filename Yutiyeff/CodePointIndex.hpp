@@ -0,0 +1,65 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Yutiyeff (https://github.com/Hapaxia/Yutiyeff)
+//
+// Copyright(c) 2023-2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace yutiyeff
+{
+
+namespace priv
+{
+
+// breadcrumbs that map every "stride"th code point to the offset of its first code unit so that a code point can be found by index with
+// a short scan. built the first time it is needed (for sequences that are long enough) and then kept until the sequence changes
+template <class CharT>
+class CodePointIndex
+{
+public:
+	std::size_t find(const std::basic_string<CharT>& sequence, std::size_t index); // the offset of code point "index" (or the size of the sequence if there are not that many)
+	void shift(std::size_t index, std::ptrdiff_t difference); // code units were added to (or removed from) code point "index"
+	void reset();
+
+private:
+	static const std::size_t stride{ 64u };
+	static const std::size_t minimumSequenceSize{ 256u }; // shorter sequences are just scanned
+
+	std::vector<std::size_t> m_offsets;
+	bool m_isBuilt{ false };
+
+	void priv_build(const std::basic_string<CharT>& sequence);
+};
+
+} // namespace priv
+
+} // namespace yutiyeff
@@ -0,0 +1,89 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Yutiyeff (https://github.com/Hapaxia/Yutiyeff)
+//
+// Copyright(c) 2023-2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include "CodePointIndex.hpp"
+#include "Kernels.inl"
+
+namespace yutiyeff
+{
+
+namespace priv
+{
+
+template <class CharT>
+inline std::size_t CodePointIndex<CharT>::find(const std::basic_string<CharT>& sequence, const std::size_t index)
+{
+	const CharT* const begin{ sequence.data() };
+	const CharT* const end{ begin + sequence.size() };
+	if (sequence.size() < minimumSequenceSize)
+		return static_cast<std::size_t>(findCodePoint(begin, end, index) - begin);
+
+	if (!m_isBuilt)
+		priv_build(sequence);
+	const std::size_t breadcrumb{ index / stride };
+	if (breadcrumb >= m_offsets.size())
+		return sequence.size();
+	return static_cast<std::size_t>(findCodePoint(begin + m_offsets[breadcrumb], end, index % stride) - begin);
+}
+
+template <class CharT>
+inline void CodePointIndex<CharT>::shift(const std::size_t index, const std::ptrdiff_t difference)
+{
+	if (!m_isBuilt)
+		return;
+	const std::size_t size{ m_offsets.size() };
+	for (std::size_t breadcrumb{ (index / stride) + 1u }; breadcrumb < size; ++breadcrumb)
+		m_offsets[breadcrumb] = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(m_offsets[breadcrumb]) + difference);
+}
+
+template <class CharT>
+inline void CodePointIndex<CharT>::reset()
+{
+	m_offsets.clear();
+	m_isBuilt = false;
+}
+
+template <class CharT>
+inline void CodePointIndex<CharT>::priv_build(const std::basic_string<CharT>& sequence)
+{
+	const CharT* const begin{ sequence.data() };
+	const CharT* const end{ begin + sequence.size() };
+	m_offsets.clear();
+	m_offsets.reserve(sequence.size() / stride + 1u);
+	for (const CharT* current{ findCodePoint(begin, end, 0u) }; current != end; current = findCodePoint(current, end, stride))
+		m_offsets.push_back(static_cast<std::size_t>(current - begin));
+	m_isBuilt = true;
+}
+
+} // namespace priv
+
+} // namespace yutiyeff
@@ -0,0 +1,69 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Yutiyeff (https://github.com/Hapaxia/Yutiyeff)
+//
+// Copyright(c) 2023-2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+
+namespace yutiyeff
+{
+
+// a bidirectional iterator over the code points of a string's sequence (UTF-8, UTF-16 or UTF-32), decoding each one when it is accessed.
+// it is read-only and is invalidated by any change to the string
+template <class CharT>
+class CodePointIterator
+{
+public:
+	using iterator_category = std::bidirectional_iterator_tag;
+	using value_type = char32_t;
+	using difference_type = std::ptrdiff_t;
+	using pointer = void;
+	using reference = char32_t; // code points are decoded from the sequence so they are provided by value
+
+	CodePointIterator() = default;
+	CodePointIterator(const CharT* current, const CharT* begin, const CharT* end);
+
+	char32_t operator*() const; // U+FFFD if the sequence here is invalid (which can only happen when iterating a view)
+	CodePointIterator& operator++();
+	CodePointIterator operator++(int);
+	CodePointIterator& operator--();
+	CodePointIterator operator--(int);
+
+	bool operator==(const CodePointIterator& other) const { return m_current == other.m_current; }
+	bool operator!=(const CodePointIterator& other) const { return m_current != other.m_current; }
+
+private:
+	const CharT* m_current{ nullptr }; // first code unit of the current code point
+	const CharT* m_begin{ nullptr }; // first code unit of the first code point
+	const CharT* m_end{ nullptr };
+};
+
+} // namespace yutiyeff
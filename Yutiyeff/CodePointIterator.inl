@@ -0,0 +1,87 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Yutiyeff (https://github.com/Hapaxia/Yutiyeff)
+//
+// Copyright(c) 2023-2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include "CodePointIterator.hpp"
+#include "Kernels.inl"
+
+namespace yutiyeff
+{
+
+template <class CharT>
+inline CodePointIterator<CharT>::CodePointIterator(const CharT* const current, const CharT* const begin, const CharT* const end)
+	: m_current{ current }
+	, m_begin{ begin }
+	, m_end{ end }
+{
+}
+
+template <class CharT>
+inline char32_t CodePointIterator<CharT>::operator*() const
+{
+	return priv::codePointAt(m_current, m_end);
+}
+
+template <class CharT>
+inline CodePointIterator<CharT>& CodePointIterator<CharT>::operator++()
+{
+	do
+		++m_current;
+	while ((m_current != m_end) && !priv::isCodePointStart(*m_current));
+	return *this;
+}
+
+template <class CharT>
+inline CodePointIterator<CharT> CodePointIterator<CharT>::operator++(int)
+{
+	const CodePointIterator previous{ *this };
+	++*this;
+	return previous;
+}
+
+template <class CharT>
+inline CodePointIterator<CharT>& CodePointIterator<CharT>::operator--()
+{
+	do
+		--m_current;
+	while ((m_current != m_begin) && !priv::isCodePointStart(*m_current));
+	return *this;
+}
+
+template <class CharT>
+inline CodePointIterator<CharT> CodePointIterator<CharT>::operator--(int)
+{
+	const CodePointIterator previous{ *this };
+	--*this;
+	return previous;
+}
+
+} // namespace yutiyeff
@@ -0,0 +1,87 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Yutiyeff (https://github.com/Hapaxia/Yutiyeff)
+//
+// Copyright(c) 2023-2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "StringView.hpp"
+
+namespace yutiyeff
+{
+
+// many sequences (of one encoding) stored one after another in a single buffer, like a column of a table.
+// sequence "index" is the code units from offset "index" to offset "index + 1" so there is one more offset than there are sequences.
+// a whole column is converted at once: it is sized with one pass and its sequences are converted into one buffer (so it allocates only its
+// buffer and its offsets, however many sequences there are). as with the string types, sequences are checked when a column is created from them
+// and the error policy is applied to each sequence (with Stop, an invalid sequence is left empty and, with Throw, the offset of InvalidSequence
+// counts the column's sequences as one sequence, which is the offset in "data" if the first offset is 0)
+template <class CharT>
+class StringColumn
+{
+public:
+	StringColumn() = default;
+	template <class InCharT>
+	StringColumn(const InCharT* data, const std::size_t* offsets, std::size_t count, ErrorPolicy errorPolicy = ErrorPolicy::Replace); // "count" sequences and "count + 1" offsets
+	template <class InCharT>
+	StringColumn(const StringView<InCharT>* views, std::size_t count, ErrorPolicy errorPolicy = ErrorPolicy::Replace);
+	template <class InCharT>
+	StringColumn(const std::vector<StringView<InCharT>>& views, ErrorPolicy errorPolicy = ErrorPolicy::Replace);
+	template <class InCharT>
+	StringColumn(const StringColumn<InCharT>& column); // not checked again
+
+	std::size_t getCount() const { return m_offsets.size() - 1u; } // the number of sequences
+	bool empty() const { return getCount() == 0u; }
+	StringView<CharT> operator[](std::size_t index) const; // the view is invalidated by any change to the column
+
+	const CharT* getData() const { return m_data.data(); }
+	std::size_t getDataSize() const { return m_data.size(); } // in code units
+	const std::size_t* getOffsets() const { return m_offsets.data(); } // "getCount() + 1" offsets (in code units)
+
+	void swap(StringColumn& other);
+
+private:
+	std::basic_string<CharT> m_data;
+	std::vector<std::size_t> m_offsets{ std::vector<std::size_t>(1u, 0u) };
+
+	template <class InCharT, class SequenceAt>
+	void priv_assign(std::size_t count, const SequenceAt& sequenceAt, std::size_t dataSize); // converts (valid) sequences. "dataSize" is their converted size
+	template <class InCharT, class SequenceAt>
+	void priv_assignRepaired(std::size_t count, const SequenceAt& sequenceAt, ErrorPolicy errorPolicy); // repairs (or removes) the invalid sequences first
+};
+
+using Utf8StringColumn = StringColumn<char>;
+using Utf16StringColumn = StringColumn<char16_t>;
+using Utf32StringColumn = StringColumn<char32_t>;
+
+} // namespace yutiyeff
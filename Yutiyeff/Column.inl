@@ -0,0 +1,195 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Yutiyeff (https://github.com/Hapaxia/Yutiyeff)
+//
+// Copyright(c) 2023-2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+
+#pragma once
+
+#include "Column.hpp"
+
+namespace yutiyeff
+{
+
+namespace priv
+{
+
+// the sequences of a column by index
+template <class CharT>
+struct ColumnSequences
+{
+	const CharT* data;
+	const std::size_t* offsets;
+
+	StringView<CharT> operator()(const std::size_t index) const { return StringView<CharT>(data + offsets[index], offsets[index + 1u] - offsets[index]); }
+};
+
+template <class CharT>
+struct ViewSequences
+{
+	const StringView<CharT>* views;
+
+	StringView<CharT> operator()(const std::size_t index) const { return views[index]; }
+};
+
+// whether every sequence of a column is valid. the whole buffer is checked at once and then each sequence must start at the start of a code point
+// (so that no code point is split between two sequences)
+template <class CharT>
+inline bool isValidColumn(const CharT* const data, const std::size_t* const offsets, const std::size_t count)
+{
+	const CharT* const end{ data + offsets[count] };
+	if (findInvalid(data + offsets[0u], end) != end)
+		return false;
+	for (std::size_t index{ 1u }; index < count; ++index)
+	{
+		const CharT* const begin{ data + offsets[index] };
+		if ((begin != end) && !isCodePointStart(*begin))
+			return false;
+	}
+	return true;
+}
+
+} // namespace priv
+
+template <class CharT>
+template <class InCharT>
+inline StringColumn<CharT>::StringColumn(const InCharT* const data, const std::size_t* const offsets, const std::size_t count, const ErrorPolicy errorPolicy)
+{
+	if (count == 0u)
+		return;
+	const priv::ColumnSequences<InCharT> sequences{ data, offsets };
+	if ((errorPolicy != ErrorPolicy::AssumeValid) && !priv::isValidColumn(data, offsets, count))
+		priv_assignRepaired<InCharT>(count, sequences, errorPolicy);
+	else
+		priv_assign<InCharT>(count, sequences, priv::convertedLength(data + offsets[0u], data + offsets[count], CharT{}));
+}
+
+template <class CharT>
+template <class InCharT>
+inline StringColumn<CharT>::StringColumn(const StringView<InCharT>* const views, const std::size_t count, const ErrorPolicy errorPolicy)
+{
+	std::size_t dataSize{ 0u };
+	for (std::size_t index{ 0u }; index < count; ++index)
+	{
+		const InCharT* const in{ views[index].getData() };
+		const InCharT* const end{ in + views[index].getDataSize() };
+		if ((errorPolicy != ErrorPolicy::AssumeValid) && (priv::findInvalid(in, end) != end))
+		{
+			priv_assignRepaired<InCharT>(count, priv::ViewSequences<InCharT>{ views }, errorPolicy);
+			return;
+		}
+		dataSize += priv::convertedLength(in, end, CharT{});
+	}
+	priv_assign<InCharT>(count, priv::ViewSequences<InCharT>{ views }, dataSize);
+}
+
+template <class CharT>
+template <class InCharT>
+inline StringColumn<CharT>::StringColumn(const std::vector<StringView<InCharT>>& views, const ErrorPolicy errorPolicy)
+	: StringColumn(views.data(), views.size(), errorPolicy)
+{
+}
+
+template <class CharT>
+template <class InCharT>
+inline StringColumn<CharT>::StringColumn(const StringColumn<InCharT>& column)
+	: StringColumn(column.getData(), column.getOffsets(), column.getCount(), ErrorPolicy::AssumeValid)
+{
+}
+
+template <class CharT>
+inline StringView<CharT> StringColumn<CharT>::operator[](const std::size_t index) const
+{
+	return StringView<CharT>(m_data.data() + m_offsets[index], m_offsets[index + 1u] - m_offsets[index]);
+}
+
+template <class CharT>
+inline void StringColumn<CharT>::swap(StringColumn& other)
+{
+	m_data.swap(other.m_data);
+	m_offsets.swap(other.m_offsets);
+}
+
+template <class CharT>
+template <class InCharT, class SequenceAt>
+inline void StringColumn<CharT>::priv_assign(const std::size_t count, const SequenceAt& sequenceAt, const std::size_t dataSize)
+{
+	const priv::StatsScope statsScope{ StatsOperation::Column };
+
+	// the sequences are converted in order so the kernel overrun past each one is only ever written into room that the next sequence has not
+	// used yet (and there is room for it after the last one)
+	m_data.assign(dataSize + priv::kernelOverrun<CharT>(), CharT{});
+	m_offsets.resize(count + 1u);
+	m_offsets[0u] = 0u;
+
+	CharT* const begin{ &m_data[0u] };
+	CharT* out{ begin };
+	std::size_t inSize{ 0u };
+	for (std::size_t index{ 0u }; index < count; ++index)
+	{
+		const StringView<InCharT> sequence{ sequenceAt(index) };
+		out = priv::transcodeOrCopy(sequence.getData(), sequence.getData() + sequence.getDataSize(), out);
+		m_offsets[index + 1u] = static_cast<std::size_t>(out - begin);
+		inSize += sequence.getDataSize();
+	}
+	m_data.resize(static_cast<std::size_t>(out - begin));
+	priv::countTranscode<CharT, InCharT>(inSize);
+	priv::countAllocation(m_data);
+	priv::countAllocation(m_offsets.capacity() * sizeof(std::size_t));
+}
+
+template <class CharT>
+template <class InCharT, class SequenceAt>
+inline void StringColumn<CharT>::priv_assignRepaired(const std::size_t count, const SequenceAt& sequenceAt, const ErrorPolicy errorPolicy)
+{
+	// only for columns with invalid sequences: a valid copy of the column is made (in its own encoding) and then that is converted
+	const priv::StatsScope statsScope{ StatsOperation::Column };
+	std::basic_string<InCharT> data;
+	std::vector<std::size_t> offsets(1u, 0u);
+	offsets.reserve(count + 1u);
+	std::size_t inOffset{ 0u }; // of the sequence in the column (as if its sequences were one sequence)
+	for (std::size_t index{ 0u }; index < count; ++index)
+	{
+		const StringView<InCharT> sequence{ sequenceAt(index) };
+		const InCharT* const in{ sequence.getData() };
+		const InCharT* const end{ in + sequence.getDataSize() };
+		const InCharT* const invalid{ priv::findInvalid(in, end) };
+		if (invalid == end)
+			data.append(in, end);
+		else if (errorPolicy == ErrorPolicy::Throw)
+			throw InvalidSequence(inOffset + static_cast<std::size_t>(invalid - in));
+		else if (errorPolicy != ErrorPolicy::Stop)
+			data += priv::repairedSequence(in, end, invalid, errorPolicy == ErrorPolicy::Replace);
+		offsets.push_back(data.size());
+		inOffset += sequence.getDataSize();
+	}
+	const InCharT* const begin{ data.data() };
+	priv_assign<InCharT>(count, priv::ColumnSequences<InCharT>{ begin, offsets.data() }, priv::convertedLength(begin, begin + data.size(), CharT{}));
+}
+
+} // namespace yutiyeff
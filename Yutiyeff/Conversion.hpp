@@ -0,0 +1,64 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Yutiyeff (https://github.com/Hapaxia/Yutiyeff)
+//
+// Copyright(c) 2023-2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "StringView.hpp"
+
+namespace yutiyeff
+{
+
+// conversions into storage that the caller already has, so that converting many sequences (e.g. one per message) needs no allocations once the storage is large enough.
+// the sequence is expected to be valid (e.g. the sequence of a string or one that has been checked); invalid sequences are dropped (as they are when converting a string)
+
+// the number of code units that converting a sequence into OutCharT produces, measured without converting it. exact for a valid sequence and never too small otherwise
+template <class OutCharT, class InCharT>
+std::size_t getConvertedLength(const StringView<InCharT>& sequence);
+template <class OutCharT, class T, class CharT>
+std::size_t getConvertedLength(const String<T, CharT>& string);
+
+// converts a sequence into a buffer of "outSize" code units and returns the number of code units written, or npos (writing nothing) if the buffer is too small.
+// a buffer of exactly "getConvertedLength" is enough; one with another 64 bytes is converted by the SIMD kernels, which can write (but not produce) that far past their output
+template <class OutCharT, class InCharT>
+std::size_t convertInto(const StringView<InCharT>& sequence, OutCharT* out, std::size_t outSize);
+template <class OutCharT, class T, class CharT>
+std::size_t convertInto(const String<T, CharT>& string, OutCharT* out, std::size_t outSize);
+
+// converts a sequence into a string, replacing its contents but keeping (and only allocating if it must grow) its capacity
+template <class OutCharT, class Traits, class Allocator, class InCharT>
+void convertInto(const StringView<InCharT>& sequence, std::basic_string<OutCharT, Traits, Allocator>& out);
+template <class OutCharT, class Traits, class Allocator, class T, class CharT>
+void convertInto(const String<T, CharT>& string, std::basic_string<OutCharT, Traits, Allocator>& out);
+
+} // namespace yutiyeff
@@ -0,0 +1,110 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Yutiyeff (https://github.com/Hapaxia/Yutiyeff)
+//
+// Copyright(c) 2023-2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+
+#pragma once
+
+#include "Conversion.hpp"
+#include "Kernels.inl"
+#include "Simd.inl"
+
+namespace yutiyeff
+{
+
+namespace priv
+{
+
+// converts a sequence into room of "outSize" code units, which must be at least its converted length ("length").
+// the SIMD kernels are only used when the room includes their overrun (see kernelOverrun); otherwise it is converted exactly
+template <class OutT, class InT>
+inline OutT* convertIntoRoom(const InT* const in, const InT* const end, OutT* const out, const std::size_t outSize, const std::size_t length)
+{
+	countTranscode<OutT, InT>(static_cast<std::size_t>(end - in));
+	if ((outSize - length) >= kernelOverrun<OutT>())
+		return transcodeOrCopy(in, end, out);
+	return transcodeOrCopyExactly(in, end, out);
+}
+
+} // namespace priv
+
+template <class OutCharT, class InCharT>
+inline std::size_t getConvertedLength(const StringView<InCharT>& sequence)
+{
+	return priv::convertedLength(sequence.getData(), sequence.getData() + sequence.getDataSize(), OutCharT{});
+}
+
+template <class OutCharT, class T, class CharT>
+inline std::size_t getConvertedLength(const String<T, CharT>& string)
+{
+	return getConvertedLength<OutCharT>(string.getView());
+}
+
+template <class OutCharT, class InCharT>
+inline std::size_t convertInto(const StringView<InCharT>& sequence, OutCharT* const out, const std::size_t outSize)
+{
+	const InCharT* const in{ sequence.getData() };
+	const InCharT* const end{ in + sequence.getDataSize() };
+	const std::size_t length{ priv::convertedLength(in, end, OutCharT{}) };
+	if (length > outSize)
+		return std::basic_string<OutCharT>::npos;
+	return static_cast<std::size_t>(priv::convertIntoRoom(in, end, out, outSize, length) - out);
+}
+
+template <class OutCharT, class T, class CharT>
+inline std::size_t convertInto(const String<T, CharT>& string, OutCharT* const out, const std::size_t outSize)
+{
+	return convertInto(string.getView(), out, outSize);
+}
+
+template <class OutCharT, class Traits, class Allocator, class InCharT>
+inline void convertInto(const StringView<InCharT>& sequence, std::basic_string<OutCharT, Traits, Allocator>& out)
+{
+	const InCharT* const in{ sequence.getData() };
+	const InCharT* const end{ in + sequence.getDataSize() };
+	const std::size_t length{ priv::convertedLength(in, end, OutCharT{}) };
+	const std::size_t overrunSize{ priv::kernelOverrun<OutCharT>() };
+	const std::size_t capacity{ out.capacity() };
+
+	// a string that must grow is given the overrun as well (so it is converted by the SIMD kernels from then on); otherwise only its current capacity is used
+	out.resize((((length + overrunSize) <= capacity) || (length > capacity)) ? (length + overrunSize) : length);
+	if (out.capacity() != capacity)
+		priv::countAllocation(out.capacity() * sizeof(OutCharT));
+	OutCharT* const begin{ &out[0] };
+	const OutCharT* const outEnd{ priv::convertIntoRoom(in, end, begin, out.size(), length) };
+	out.resize(static_cast<std::size_t>(outEnd - begin));
+}
+
+template <class OutCharT, class Traits, class Allocator, class T, class CharT>
+inline void convertInto(const String<T, CharT>& string, std::basic_string<OutCharT, Traits, Allocator>& out)
+{
+	convertInto(string.getView(), out);
+}
+
+} // namespace yutiyeff
@@ -0,0 +1,116 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Yutiyeff (https://github.com/Hapaxia/Yutiyeff)
+//
+// Copyright(c) 2023-2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "CodePointIterator.hpp"
+#include "StringView.hpp"
+
+namespace yutiyeff
+{
+
+// a string (UTF-8, UTF-16 or UTF-32, by code unit type) of a fixed number of code units that is encoded and checked when it is created, which can only
+// be at compile time (C++20). a literal (e.g. "héllo"_u16) is a constant in the program's data so it costs nothing at runtime and its sequence can be
+// viewed, or copied into a string, without being converted or checked again
+template <class CharT, std::size_t size>
+class FixedString
+{
+public:
+	using const_iterator = CodePointIterator<CharT>;
+	using iterator = const_iterator;
+
+	// a literal in any encoding, which must be valid and encode into exactly "size" code units (otherwise it does not compile)
+	template <class InCharT, std::size_t inSize>
+	consteval FixedString(const InCharT (&literal)[inSize]);
+
+	// the string types (converted only if they are in another encoding)
+	Utf8String getUtf8String() const;
+	Utf16String getUtf16String() const;
+	Utf32String getUtf32String() const;
+	std::string getString() const; // get a standard std::string representing the UTF-8 formatted version of the string
+	std::string getNonUnicodeString() const; // get a standard std::string of only the codes in the 0-127 range
+
+	constexpr std::size_t length() const;
+	constexpr char32_t operator[](std::size_t index) const;
+	constexpr bool empty() const { return size == 0u; }
+
+	StringView<CharT> getView() const { return StringView<CharT>(m_units, size); }
+	operator StringView<CharT>() const { return getView(); }
+
+	constexpr const CharT* getData() const { return m_units; } // null-terminated
+	constexpr std::size_t getDataSize() const { return size; } // in code units
+	std::basic_string<CharT> getSequence() const { return std::basic_string<CharT>(m_units, size); } // copies the sequence
+
+	const_iterator begin() const { return getView().begin(); }
+	const_iterator end() const { return getView().end(); }
+
+private:
+	CharT m_units[size + 1u]{ };
+};
+
+template <std::size_t size>
+using FixedUtf8String = FixedString<char, size>;
+template <std::size_t size>
+using FixedUtf16String = FixedString<char16_t, size>;
+template <std::size_t size>
+using FixedUtf32String = FixedString<char32_t, size>;
+
+namespace priv
+{
+
+// a string literal (of any encoding) as a template parameter
+template <class CharT, std::size_t size>
+struct Literal
+{
+	CharT units[size];
+
+	constexpr Literal(const CharT (&literal)[size]);
+};
+
+} // namespace priv
+
+// e.g. "héllo"_u16 is a FixedString<char16_t, 5>. the literal can be in any encoding (u8"", u"", U"" or "", which must be UTF-8)
+inline namespace literals
+{
+
+template <priv::Literal literal>
+consteval auto operator""_u8();
+template <priv::Literal literal>
+consteval auto operator""_u16();
+template <priv::Literal literal>
+consteval auto operator""_u32();
+
+} // namespace literals
+
+} // namespace yutiyeff
@@ -0,0 +1,210 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Yutiyeff (https://github.com/Hapaxia/Yutiyeff)
+//
+// Copyright(c) 2023-2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+
+#pragma once
+
+#include "FixedString.hpp"
+
+#include <type_traits>
+
+namespace yutiyeff
+{
+namespace priv
+{
+
+template <class CharT, std::size_t size>
+constexpr Literal<CharT, size>::Literal(const CharT (&literal)[size])
+{
+	for (std::size_t i{ 0u }; i < size; ++i)
+		units[i] = literal[i];
+}
+
+// the code units of a literal as they are decoded (u8 literals are UTF-8 in char8_t)
+template <class CharT>
+struct LiteralUnit
+{
+	using Type = CharT;
+};
+
+template <>
+struct LiteralUnit<char8_t>
+{
+	using Type = char;
+};
+
+// not constexpr so that calling it while creating a fixed string (at compile time) does not compile
+inline void invalidLiteral()
+{
+}
+
+// the code units of a literal (including its null terminator) as the type that they are decoded as
+template <class InCharT, std::size_t inSize>
+consteval Literal<typename LiteralUnit<InCharT>::Type, inSize> literalUnits(const InCharT (&literal)[inSize])
+{
+	using Unit = typename LiteralUnit<InCharT>::Type;
+	Unit units[inSize]{ };
+	for (std::size_t i{ 0u }; i < inSize; ++i)
+		units[i] = static_cast<Unit>(literal[i]);
+	return Literal<Unit, inSize>(units);
+}
+
+// the number of code units that a literal (without its null terminator) encodes into. it must be valid
+template <class OutT, class InCharT, std::size_t inSize>
+consteval std::size_t encodedSize(const InCharT (&literal)[inSize])
+{
+	const auto units{ literalUnits(literal) };
+	const auto* in{ units.units };
+	const auto* const end{ in + inSize - 1u };
+	if (*end != 0)
+		invalidLiteral();
+	std::size_t size{ 0u };
+	while (in != end)
+	{
+		const auto* const start{ in };
+		if (!checkSequence(in, end))
+			invalidLiteral();
+		OutT encoded[4]{ };
+		OutT* encodedEnd{ encoded };
+		encode(validCodePointAt(start), encodedEnd);
+		size += static_cast<std::size_t>(encodedEnd - encoded);
+	}
+	return size;
+}
+
+} // namespace priv
+
+template <class CharT, std::size_t size>
+template <class InCharT, std::size_t inSize>
+consteval FixedString<CharT, size>::FixedString(const InCharT (&literal)[inSize])
+{
+	if (priv::encodedSize<CharT>(literal) != size) // also checks it
+		priv::invalidLiteral();
+	const auto units{ priv::literalUnits(literal) };
+	const auto* const in{ units.units };
+	if constexpr (std::is_same<typename priv::LiteralUnit<InCharT>::Type, CharT>::value)
+	{
+		for (std::size_t i{ 0u }; i < size; ++i)
+			m_units[i] = in[i];
+	}
+	else
+		priv::scalar::transcode(in, in + inSize - 1u, m_units); // the scalar kernels write exactly what they produce
+}
+
+template <class CharT, std::size_t size>
+inline Utf8String FixedString<CharT, size>::getUtf8String() const
+{
+	return Utf8String::fromSequence(priv::sequenceOf(m_units, m_units + size, char{}), ErrorPolicy::AssumeValid);
+}
+
+template <class CharT, std::size_t size>
+inline Utf16String FixedString<CharT, size>::getUtf16String() const
+{
+	return Utf16String::fromSequence(priv::sequenceOf(m_units, m_units + size, char16_t{}), ErrorPolicy::AssumeValid);
+}
+
+template <class CharT, std::size_t size>
+inline Utf32String FixedString<CharT, size>::getUtf32String() const
+{
+	return Utf32String::fromSequence(priv::sequenceOf(m_units, m_units + size, char32_t{}), ErrorPolicy::AssumeValid);
+}
+
+template <class CharT, std::size_t size>
+inline std::string FixedString<CharT, size>::getString() const
+{
+	const priv::StatsScope statsScope{ StatsOperation::Output };
+	return priv::utf8String(m_units, m_units + size);
+}
+
+template <class CharT, std::size_t size>
+inline std::string FixedString<CharT, size>::getNonUnicodeString() const
+{
+	const priv::StatsScope statsScope{ StatsOperation::Output };
+	return priv::nonUnicodeString(m_units, m_units + size);
+}
+
+template <class CharT, std::size_t size>
+constexpr std::size_t FixedString<CharT, size>::length() const
+{
+	std::size_t length{ 0u };
+	for (std::size_t i{ 0u }; i < size; ++i)
+	{
+		if (priv::isCodePointStart(m_units[i]))
+			++length;
+	}
+	return length;
+}
+
+template <class CharT, std::size_t size>
+constexpr char32_t FixedString<CharT, size>::operator[](std::size_t index) const
+{
+	for (const CharT* current{ m_units }; current != (m_units + size); current += priv::sequenceLength(*current))
+	{
+		if (index-- == 0u)
+			return priv::validCodePointAt(current);
+	}
+	return 0u;
+}
+
+inline namespace literals
+{
+
+template <priv::Literal literal>
+consteval auto operator""_u8()
+{
+	return FixedString<char, priv::encodedSize<char>(literal.units)>(literal.units);
+}
+
+template <priv::Literal literal>
+consteval auto operator""_u16()
+{
+	return FixedString<char16_t, priv::encodedSize<char16_t>(literal.units)>(literal.units);
+}
+
+template <priv::Literal literal>
+consteval auto operator""_u32()
+{
+	return FixedString<char32_t, priv::encodedSize<char32_t>(literal.units)>(literal.units);
+}
+
+} // namespace literals
+
+} // namespace yutiyeff
+
+namespace std
+{
+
+template <class CharT, std::size_t size>
+struct hash<yutiyeff::FixedString<CharT, size>>
+{
+	std::size_t operator()(const yutiyeff::FixedString<CharT, size>& string) const { return hash<yutiyeff::StringView<CharT>>{}(string.getView()); }
+};
+
+} // namespace std
@@ -0,0 +1,701 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Yutiyeff (https://github.com/Hapaxia/Yutiyeff)
+//
+// Copyright(c) 2023-2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+namespace yutiyeff
+{
+
+namespace priv
+{
+
+// whether this is being evaluated at compile time, where the SWAR blocks below (which load words with memcpy) can't be used
+YUTIYEFF_CONSTEXPR inline bool isConstantEvaluated()
+{
+#ifdef YUTIYEFF_CPP20
+	return std::is_constant_evaluated();
+#else // YUTIYEFF_CPP20
+	return false;
+#endif // YUTIYEFF_CPP20
+}
+
+// ASCII RUNS (SWAR)
+
+inline std::uint64_t loadWord(const void* pointer)
+{
+	std::uint64_t word;
+	std::memcpy(&word, pointer, sizeof(word));
+	return word;
+}
+
+YUTIYEFF_CONSTEXPR inline bool isAscii(const char unit) { return !(static_cast<unsigned char>(unit) & 0x80); }
+YUTIYEFF_CONSTEXPR inline bool isAscii(const char16_t unit) { return unit <= 0x7F; }
+YUTIYEFF_CONSTEXPR inline bool isAscii(const char32_t unit) { return unit <= 0x7F; }
+
+// checks 16 bytes (16, 8 or 4 code units) at once for any value outside of the 0-127 range
+inline bool isAsciiBlock(const char* block) { return !((loadWord(block) | loadWord(block + 8)) & 0x8080808080808080u); }
+inline bool isAsciiBlock(const char16_t* block) { return !((loadWord(block) | loadWord(block + 4)) & 0xFF80FF80FF80FF80u); }
+inline bool isAsciiBlock(const char32_t* block) { return !((loadWord(block) | loadWord(block + 2)) & 0xFFFFFF80FFFFFF80u); }
+
+// copies (widening or narrowing) the run of ASCII code units at the start of the input and returns how many were copied
+template <class InT, class OutT>
+YUTIYEFF_CONSTEXPR inline std::size_t asciiRun(const InT* const in, const InT* const end, OutT* const out)
+{
+	const std::size_t blockLength{ 16u / sizeof(InT) };
+	const std::size_t inLength{ static_cast<std::size_t>(end - in) };
+	std::size_t count{ 0u };
+	for (; !isConstantEvaluated() && ((count + blockLength) <= inLength); count += blockLength)
+	{
+		InT block[blockLength]; // a local copy can't alias the output so the copy below can be vectorised by the compiler
+		std::memcpy(block, in + count, sizeof(block));
+		if (!isAsciiBlock(block))
+			break;
+		for (std::size_t i{ 0u }; i < blockLength; ++i)
+			out[count + i] = static_cast<OutT>(block[i]);
+	}
+	for (; (count < inLength) && isAscii(in[count]); ++count)
+		out[count] = static_cast<OutT>(in[count]);
+	return count;
+}
+
+
+
+// CODE POINT POSITIONS
+// every byte that is not a continuation byte (10xxxxxx) and every code unit that is not a low surrogate starts a code point.
+// code points are counted (and found by index) this way, without decoding.
+
+YUTIYEFF_CONSTEXPR inline bool isCodePointStart(const char unit) { return (static_cast<unsigned char>(unit) & 0xC0) != 0x80; }
+YUTIYEFF_CONSTEXPR inline bool isCodePointStart(const char16_t unit) { return (unit & 0xFC00) != 0xDC00; }
+YUTIYEFF_CONSTEXPR inline bool isCodePointStart(const char32_t) { return true; }
+
+// the number of bytes in an 8-byte word that start a code point
+inline std::size_t codePointStartsInWord(const std::uint64_t word)
+{
+	const std::uint64_t continuations{ (word >> 7u) & ~(word >> 6u) & 0x0101010101010101u }; // the low bit of each byte is set for continuation bytes
+	return 8u - static_cast<std::size_t>((continuations * 0x0101010101010101u) >> 56u); // the multiply sums the bytes into the top byte
+}
+
+// the first code unit of code point "index" (counted from "in") or "end" if there are not that many code points
+inline const char* findCodePoint(const char* in, const char* const end, std::size_t index)
+{
+	for (; (end - in) >= 8; in += 8)
+	{
+		const std::size_t starts{ codePointStartsInWord(loadWord(in)) };
+		if (starts > index)
+			break;
+		index -= starts;
+	}
+	for (; in != end; ++in)
+	{
+		if (!isCodePointStart(*in))
+			continue;
+		if (index == 0u)
+			return in;
+		--index;
+	}
+	return end;
+}
+
+inline const char16_t* findCodePoint(const char16_t* in, const char16_t* const end, std::size_t index)
+{
+	for (; in != end; ++in)
+	{
+		if (!isCodePointStart(*in))
+			continue;
+		if (index == 0u)
+			return in;
+		--index;
+	}
+	return end;
+}
+
+inline const char32_t* findCodePoint(const char32_t* const in, const char32_t* const end, const std::size_t index)
+{
+	return (index < static_cast<std::size_t>(end - in)) ? (in + index) : end;
+}
+
+
+
+// VALIDATION
+// a sequence is valid if it is the shortest encoding of a code point in the Unicode range that is not a surrogate.
+// each of these moves "current" past the sequence (or, if it is invalid, past the part of it that could have started a valid
+// sequence - its "maximal subpart" - so that each invalid part can be replaced by a single U+FFFD) and returns whether it is valid
+
+YUTIYEFF_CONSTEXPR inline bool checkSequence(const char*& current, const char* const end)
+{
+	const unsigned char lead{ static_cast<unsigned char>(*current++) };
+	if (lead < 0x80)
+		return true;
+
+	// the range of the second byte depends on the lead (to exclude overlong forms, surrogates and values above 0x10FFFF)
+	std::size_t length;
+	unsigned char low{ 0x80 };
+	unsigned char high{ 0xBF };
+	if ((lead >= 0xC2) && (lead <= 0xDF))
+		length = 2u;
+	else if ((lead >= 0xE0) && (lead <= 0xEF))
+	{
+		length = 3u;
+		if (lead == 0xE0)
+			low = 0xA0;
+		else if (lead == 0xED)
+			high = 0x9F;
+	}
+	else if ((lead >= 0xF0) && (lead <= 0xF4))
+	{
+		length = 4u;
+		if (lead == 0xF0)
+			low = 0x90;
+		else if (lead == 0xF4)
+			high = 0x8F;
+	}
+	else
+		return false;
+
+	for (std::size_t i{ 1u }; i < length; ++i)
+	{
+		if (current == end)
+			return false;
+		const unsigned char byte{ static_cast<unsigned char>(*current) };
+		if ((byte < low) || (byte > high))
+			return false;
+		++current;
+		low = 0x80;
+		high = 0xBF;
+	}
+	return true;
+}
+
+YUTIYEFF_CONSTEXPR inline bool checkSequence(const char16_t*& current, const char16_t* const end)
+{
+	const char16_t unit{ *current++ };
+	if ((unit & 0xF800) != 0xD800)
+		return true;
+	if ((unit >= 0xDC00) || (current == end) || ((*current & 0xFC00) != 0xDC00))
+		return false;
+	++current;
+	return true;
+}
+
+YUTIYEFF_CONSTEXPR inline bool isValidCodePoint(const char32_t codePoint)
+{
+	return (codePoint < 0xD800) || ((codePoint > 0xDFFF) && (codePoint <= 0x10FFFF));
+}
+
+YUTIYEFF_CONSTEXPR inline bool checkSequence(const char32_t*& current, const char32_t* const)
+{
+	return isValidCodePoint(*current++);
+}
+
+
+
+// SINGLE CODE POINTS
+
+// the code point that starts at "current" in a sequence that is known to be valid (so nothing is checked)
+YUTIYEFF_CONSTEXPR inline char32_t validCodePointAt(const char* const current)
+{
+	const char32_t byte1{ static_cast<char32_t>(static_cast<unsigned char>(current[0])) };
+	if (byte1 < 0x80)
+		return byte1;
+	if (byte1 < 0xE0)
+		return ((byte1 & 0x1F) << 6) | (static_cast<unsigned char>(current[1]) & 0x3F);
+	if (byte1 < 0xF0)
+		return ((byte1 & 0x0F) << 12) | ((static_cast<unsigned char>(current[1]) & 0x3F) << 6) | (static_cast<unsigned char>(current[2]) & 0x3F);
+	return ((byte1 & 0x07) << 18) | ((static_cast<unsigned char>(current[1]) & 0x3F) << 12) | ((static_cast<unsigned char>(current[2]) & 0x3F) << 6) | (static_cast<unsigned char>(current[3]) & 0x3F);
+}
+
+YUTIYEFF_CONSTEXPR inline char32_t validCodePointAt(const char16_t* const current)
+{
+	const char32_t unit1{ static_cast<char32_t>(current[0]) };
+	if ((unit1 & 0xFC00) != 0xD800)
+		return unit1;
+	return (((unit1 - 0xD800) << 10) | (static_cast<char32_t>(current[1]) - 0xDC00)) + 0x10000;
+}
+
+YUTIYEFF_CONSTEXPR inline char32_t validCodePointAt(const char32_t* const current)
+{
+	return *current;
+}
+
+// decodes one code point and moves "current" past it. returns false if the sequence is invalid (and so no code point is produced), in which case
+// "current" is moved past its maximal subpart only (see checkSequence) so each invalid part is skipped as it is when a string is created
+YUTIYEFF_CONSTEXPR inline bool decodeUtf8(const char*& current, const char* const end, char32_t& codePoint)
+{
+	const char* const start{ current };
+	if (!checkSequence(current, end))
+		return false;
+	codePoint = validCodePointAt(start);
+	return true;
+}
+
+YUTIYEFF_CONSTEXPR inline bool decodeUtf16(const char16_t*& current, const char16_t* const end, char32_t& codePoint)
+{
+	const char16_t* const start{ current };
+	if (!checkSequence(current, end))
+		return false;
+	codePoint = validCodePointAt(start);
+	return true;
+}
+
+// the number of code units that decoding a sequence starting with "lead" takes (whether the sequence is valid or not)
+YUTIYEFF_CONSTEXPR inline std::size_t sequenceLength(const char lead)
+{
+	const unsigned char byte{ static_cast<unsigned char>(lead) };
+	if (!(byte & 0x80))
+		return 1u;
+	if ((byte & 0xE0) == 0xC0)
+		return 2u;
+	if ((byte & 0xF0) == 0xE0)
+		return 3u;
+	return 4u;
+}
+
+YUTIYEFF_CONSTEXPR inline std::size_t sequenceLength(const char16_t lead) { return ((lead <= 0xD7FF) || (lead >= 0xE000)) ? 1u : 2u; }
+YUTIYEFF_CONSTEXPR inline std::size_t sequenceLength(const char32_t) { return 1u; }
+
+// encodes one code point and moves "out" past it. surrogates and code points outside of the Unicode range are discarded
+YUTIYEFF_CONSTEXPR inline void encodeUtf8(const char32_t codePoint, char*& out)
+{
+	if ((codePoint >= 0xD800) && (codePoint <= 0xDFFF))
+		return;
+
+	if (codePoint <= 0x7F)
+		*out++ = static_cast<char>(codePoint);
+	else if (codePoint <= 0x7FF)
+	{
+		*out++ = static_cast<char>(0xC0 | ((codePoint >> 6) & 0x1F));
+		*out++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+	}
+	else if (codePoint <= 0xFFFF)
+	{
+		*out++ = static_cast<char>(0xE0 | ((codePoint >> 12) & 0x0F));
+		*out++ = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+		*out++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+	}
+	else if (codePoint <= 0x10FFFF)
+	{
+		*out++ = static_cast<char>(0xF0 | ((codePoint >> 18) & 0x07));
+		*out++ = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+		*out++ = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+		*out++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+	}
+}
+
+// encodes one code point and moves "out" past it. surrogates and code points outside of the Unicode range are discarded
+YUTIYEFF_CONSTEXPR inline void encodeUtf16(char32_t codePoint, char16_t*& out)
+{
+	if ((codePoint > 0x10FFFF) || ((codePoint >= 0xD800) && (codePoint <= 0xDFFF))) // invalid ranges
+		return;
+
+	if (codePoint <= 0xFFFF) // single 16-bit value
+	{
+		*out++ = static_cast<char16_t>(codePoint);
+		return;
+	}
+
+	codePoint -= 0x10000; // now in range of 0x00000-0xFFFFF (this amount can be subtracted because 0x0000 - 0xFFFF would be encoded directly, not this way)
+	*out++ = static_cast<char16_t>(((codePoint >> 10) & 0x3FF) + 0xD800);
+	*out++ = static_cast<char16_t>((codePoint & 0x3FF) + 0xDC00);
+}
+
+YUTIYEFF_CONSTEXPR inline void encode(const char32_t codePoint, char*& out) { encodeUtf8(codePoint, out); }
+YUTIYEFF_CONSTEXPR inline void encode(const char32_t codePoint, char16_t*& out) { encodeUtf16(codePoint, out); }
+YUTIYEFF_CONSTEXPR inline void encode(const char32_t codePoint, char32_t*& out) { *out++ = codePoint; }
+
+// the code point that starts at "current" (which must not be "end"). returns U+FFFD if the sequence there is invalid (as it would be in a string)
+YUTIYEFF_CONSTEXPR inline char32_t codePointAt(const char* current, const char* const end)
+{
+	char32_t codePoint;
+	return decodeUtf8(current, end, codePoint) ? codePoint : 0xFFFD;
+}
+
+YUTIYEFF_CONSTEXPR inline char32_t codePointAt(const char16_t* current, const char16_t* const end)
+{
+	char32_t codePoint;
+	return decodeUtf16(current, end, codePoint) ? codePoint : 0xFFFD;
+}
+
+YUTIYEFF_CONSTEXPR inline char32_t codePointAt(const char32_t* const current, const char32_t* const)
+{
+	return isValidCodePoint(*current) ? *current : 0xFFFD;
+}
+
+
+
+// COMPARING
+// sequences are compared (and hashed) by their code points so the results are the same whatever their encodings.
+// each invalid part (measured by its maximal subpart, see checkSequence) counts as one U+FFFD, which is what it becomes in a string
+
+// decodes the code point at "current" (which must not be "end") and moves past it
+inline char32_t nextCodePoint(const char*& current, const char* const end)
+{
+	char32_t codePoint;
+	return decodeUtf8(current, end, codePoint) ? codePoint : 0xFFFD;
+}
+
+inline char32_t nextCodePoint(const char16_t*& current, const char16_t* const end)
+{
+	char32_t codePoint;
+	return decodeUtf16(current, end, codePoint) ? codePoint : 0xFFFD;
+}
+
+inline char32_t nextCodePoint(const char32_t*& current, const char32_t* const)
+{
+	const char32_t codePoint{ *current++ };
+	return isValidCodePoint(codePoint) ? codePoint : 0xFFFD;
+}
+
+// negative, zero or positive if the first sequence is before, the same as or after the second (in code point order).
+// sequences in the same encoding are compared as code units until they differ and only the code points there are decoded. decoding starts from
+// the last code point start before the difference (each start begins a new sequence, valid or not, so that is in step with decoding from the
+// beginning) and, if the code points are the same (only possible when different invalid parts both count as U+FFFD), code units are compared
+// again once both are at the same offset
+template <class CharT>
+inline int compareCodePoints(const CharT* lhs, const CharT* const lhsEnd, const CharT* rhs, const CharT* const rhsEnd)
+{
+	const CharT* const lhsBegin{ lhs };
+	const CharT* const rhsBegin{ rhs };
+	const CharT* inStep{ lhs }; // lhs and rhs are both at the start of a sequence here (and at the same offset)
+	while (true)
+	{
+		while ((lhs != lhsEnd) && (rhs != rhsEnd) && (*lhs == *rhs))
+		{
+			++lhs;
+			++rhs;
+		}
+		if ((lhs == lhsEnd) && (rhs == rhsEnd))
+			return 0;
+		while (lhs != inStep)
+		{
+			if (isCodePointStart(*--lhs))
+				break;
+		}
+		rhs = rhsBegin + (lhs - lhsBegin);
+		do
+		{
+			if ((lhs == lhsEnd) || (rhs == rhsEnd))
+				return (lhs != lhsEnd) ? 1 : ((rhs != rhsEnd) ? -1 : 0);
+			const char32_t lhsCodePoint{ nextCodePoint(lhs, lhsEnd) };
+			const char32_t rhsCodePoint{ nextCodePoint(rhs, rhsEnd) };
+			if (lhsCodePoint != rhsCodePoint)
+				return (lhsCodePoint < rhsCodePoint) ? -1 : 1;
+		} while ((lhs - lhsBegin) != (rhs - rhsBegin));
+		inStep = lhs;
+	}
+}
+
+// sequences in different encodings are decoded together, a code point at a time
+template <class LhsT, class RhsT>
+inline int compareCodePoints(const LhsT* lhs, const LhsT* const lhsEnd, const RhsT* rhs, const RhsT* const rhsEnd)
+{
+	while ((lhs != lhsEnd) && (rhs != rhsEnd))
+	{
+		const char32_t lhsCodePoint{ nextCodePoint(lhs, lhsEnd) };
+		const char32_t rhsCodePoint{ nextCodePoint(rhs, rhsEnd) };
+		if (lhsCodePoint != rhsCodePoint)
+			return (lhsCodePoint < rhsCodePoint) ? -1 : 1;
+	}
+	return (lhs != lhsEnd) ? 1 : ((rhs != rhsEnd) ? -1 : 0);
+}
+
+// whether two sequences have the same code points. the same code units always have the same code points; otherwise (as sequences of different
+// code units can still have the same code points if they have invalid parts) they are compared
+template <class CharT>
+inline bool equalCodePoints(const CharT* const lhs, const CharT* const lhsEnd, const CharT* const rhs, const CharT* const rhsEnd)
+{
+	if (((lhsEnd - lhs) == (rhsEnd - rhs)) && ((lhs == lhsEnd) || (std::char_traits<CharT>::compare(lhs, rhs, static_cast<std::size_t>(lhsEnd - lhs)) == 0)))
+		return true;
+	return compareCodePoints(lhs, lhsEnd, rhs, rhsEnd) == 0;
+}
+
+template <class LhsT, class RhsT>
+inline bool equalCodePoints(const LhsT* const lhs, const LhsT* const lhsEnd, const RhsT* const rhs, const RhsT* const rhsEnd)
+{
+	return compareCodePoints(lhs, lhsEnd, rhs, rhsEnd) == 0;
+}
+
+// a hash of the code points of a sequence (64-bit FNV-1a with a code point at a time instead of a byte) that is the same for every encoding
+template <class CharT>
+inline std::size_t hashCodePoints(const CharT* current, const CharT* const end)
+{
+	std::uint64_t hash{ 0xCBF29CE484222325u };
+	while (current != end)
+		hash = (hash ^ nextCodePoint(current, end)) * 0x100000001B3u;
+	return static_cast<std::size_t>(hash ^ (hash >> 32u)); // folded so that a 32-bit size_t still depends on every bit
+}
+
+
+
+// FILTERING
+
+// the code units of a sequence that are in the 0-127 range (all others are skipped)
+template <class CharT>
+inline std::string nonUnicodeString(const CharT* in, const CharT* const end)
+{
+	countTranscode<char, CharT>(static_cast<std::size_t>(end - in));
+	std::string s{};
+	for (; in != end; ++in)
+	{
+		if (isAscii(*in))
+			s.push_back(static_cast<char>(*in));
+	}
+	countAllocation(s);
+	return s;
+}
+
+
+
+// SEQUENCES
+// each writes into "out" (which must have room for the largest possible result) and returns the end of what was written.
+// ASCII runs are converted in bulk; the per-code-point path is only taken from the first non-ASCII code unit.
+// the "Until" forms stop at the first sequence boundary at or after "limit" (and move "in" there).
+
+namespace scalar
+{
+
+YUTIYEFF_CONSTEXPR inline char* utf8FromUtf32(const char32_t* in, const char32_t* const end, char* out)
+{
+	while (in != end)
+	{
+		if (isAscii(*in))
+		{
+			const std::size_t count{ asciiRun(in, end, out) };
+			in += count;
+			out += count;
+			continue;
+		}
+		encodeUtf8(*in++, out);
+	}
+	return out;
+}
+
+YUTIYEFF_CONSTEXPR inline char16_t* utf16FromUtf32(const char32_t* in, const char32_t* const end, char16_t* out)
+{
+	while (in != end)
+	{
+		if (isAscii(*in))
+		{
+			const std::size_t count{ asciiRun(in, end, out) };
+			in += count;
+			out += count;
+			continue;
+		}
+		encodeUtf16(*in++, out);
+	}
+	return out;
+}
+
+YUTIYEFF_CONSTEXPR inline char32_t* utf32FromUtf8Until(const char*& in, const char* const limit, const char* const end, char32_t* out)
+{
+	char32_t codePoint;
+	while (in < limit)
+	{
+		if (isAscii(*in))
+		{
+			const std::size_t count{ asciiRun(in, limit, out) };
+			in += count;
+			out += count;
+			continue;
+		}
+		if (decodeUtf8(in, end, codePoint))
+			*out++ = codePoint;
+	}
+	return out;
+}
+
+YUTIYEFF_CONSTEXPR inline char32_t* utf32FromUtf8(const char* in, const char* const end, char32_t* out)
+{
+	return utf32FromUtf8Until(in, end, end, out);
+}
+
+YUTIYEFF_CONSTEXPR inline char32_t* utf32FromUtf16Until(const char16_t*& in, const char16_t* const limit, const char16_t* const end, char32_t* out)
+{
+	char32_t codePoint;
+	while (in < limit)
+	{
+		if (isAscii(*in))
+		{
+			const std::size_t count{ asciiRun(in, limit, out) };
+			in += count;
+			out += count;
+			continue;
+		}
+		if (decodeUtf16(in, end, codePoint))
+			*out++ = codePoint;
+	}
+	return out;
+}
+
+YUTIYEFF_CONSTEXPR inline char32_t* utf32FromUtf16(const char16_t* in, const char16_t* const end, char32_t* out)
+{
+	return utf32FromUtf16Until(in, end, end, out);
+}
+
+YUTIYEFF_CONSTEXPR inline char* utf8FromUtf16Until(const char16_t*& in, const char16_t* const limit, const char16_t* const end, char* out)
+{
+	char32_t codePoint;
+	while (in < limit)
+	{
+		if (isAscii(*in))
+		{
+			const std::size_t count{ asciiRun(in, limit, out) };
+			in += count;
+			out += count;
+			continue;
+		}
+		if (decodeUtf16(in, end, codePoint))
+			encodeUtf8(codePoint, out);
+	}
+	return out;
+}
+
+YUTIYEFF_CONSTEXPR inline char* utf8FromUtf16(const char16_t* in, const char16_t* const end, char* out)
+{
+	return utf8FromUtf16Until(in, end, end, out);
+}
+
+YUTIYEFF_CONSTEXPR inline char16_t* utf16FromUtf8Until(const char*& in, const char* const limit, const char* const end, char16_t* out)
+{
+	char32_t codePoint;
+	while (in < limit)
+	{
+		if (isAscii(*in))
+		{
+			const std::size_t count{ asciiRun(in, limit, out) };
+			in += count;
+			out += count;
+			continue;
+		}
+		if (decodeUtf8(in, end, codePoint))
+			encodeUtf16(codePoint, out);
+	}
+	return out;
+}
+
+YUTIYEFF_CONSTEXPR inline char16_t* utf16FromUtf8(const char* in, const char* const end, char16_t* out)
+{
+	return utf16FromUtf8Until(in, end, end, out);
+}
+
+// the same, chosen by code unit type. the scalar kernels write only what they produce so they can write into room of exactly the converted length
+YUTIYEFF_CONSTEXPR inline char* transcode(const char32_t* const in, const char32_t* const end, char* const out) { return utf8FromUtf32(in, end, out); }
+YUTIYEFF_CONSTEXPR inline char16_t* transcode(const char32_t* const in, const char32_t* const end, char16_t* const out) { return utf16FromUtf32(in, end, out); }
+YUTIYEFF_CONSTEXPR inline char32_t* transcode(const char* const in, const char* const end, char32_t* const out) { return utf32FromUtf8(in, end, out); }
+YUTIYEFF_CONSTEXPR inline char32_t* transcode(const char16_t* const in, const char16_t* const end, char32_t* const out) { return utf32FromUtf16(in, end, out); }
+YUTIYEFF_CONSTEXPR inline char* transcode(const char16_t* const in, const char16_t* const end, char* const out) { return utf8FromUtf16(in, end, out); }
+YUTIYEFF_CONSTEXPR inline char16_t* transcode(const char* const in, const char* const end, char16_t* const out) { return utf16FromUtf8(in, end, out); }
+
+// COUNTING
+// the number of code points in a sequence, without decoding (see isCodePointStart)
+
+inline std::size_t codePointCountUtf8(const char* in, const char* const end)
+{
+	std::size_t count{ 0u };
+	for (; (end - in) >= 8; in += 8)
+		count += codePointStartsInWord(loadWord(in));
+	for (; in != end; ++in)
+	{
+		if (isCodePointStart(*in))
+			++count;
+	}
+	return count;
+}
+
+inline std::size_t codePointCountUtf16(const char16_t* in, const char16_t* const end)
+{
+	std::size_t count{ 0u };
+	for (; in != end; ++in)
+	{
+		if (isCodePointStart(*in))
+			++count;
+	}
+	return count;
+}
+
+// SEARCHING
+// the first occurrence of a (non-empty) needle of code units or "end" if there is none. matches are of code units only;
+// whether they are on code point boundaries is checked by the caller
+
+template <class CharT>
+inline const CharT* findUnits(const CharT* in, const CharT* const end, const CharT* const needle, const std::size_t needleLength)
+{
+	using Traits = std::char_traits<CharT>;
+	if (static_cast<std::size_t>(end - in) < needleLength)
+		return end;
+	const CharT* const lastStart{ end - needleLength };
+	while (in <= lastStart)
+	{
+		in = Traits::find(in, static_cast<std::size_t>(lastStart - in) + 1u, needle[0]); // memchr for bytes
+		if (in == nullptr)
+			return end;
+		if (Traits::compare(in, needle, needleLength) == 0)
+			return in;
+		++in;
+	}
+	return end;
+}
+
+inline const char* findUtf8(const char* const in, const char* const end, const char* const needle, const std::size_t needleLength) { return findUnits(in, end, needle, needleLength); }
+inline const char16_t* findUtf16(const char16_t* const in, const char16_t* const end, const char16_t* const needle, const std::size_t needleLength) { return findUnits(in, end, needle, needleLength); }
+
+// VALIDATING
+// the first code unit of the first invalid sequence (see checkSequence) or "end" if all of it is valid
+
+template <class CharT>
+inline const CharT* findInvalid(const CharT* in, const CharT* const end)
+{
+	const std::size_t blockSize{ 16u / sizeof(CharT) };
+	while (in != end)
+	{
+		if ((static_cast<std::size_t>(end - in) >= blockSize) && isAsciiBlock(in))
+		{
+			in += blockSize;
+			continue;
+		}
+		const CharT* const start{ in };
+		if (!checkSequence(in, end))
+			return start;
+	}
+	return end;
+}
+
+inline const char* findInvalidUtf8(const char* const in, const char* const end) { return findInvalid(in, end); }
+inline const char16_t* findInvalidUtf16(const char16_t* const in, const char16_t* const end) { return findInvalid(in, end); }
+
+} // namespace scalar
+
+} // namespace priv
+
+} // namespace yutiyeff
@@ -0,0 +1,101 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Yutiyeff (https://github.com/Hapaxia/Yutiyeff)
+//
+// Copyright(c) 2023-2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "StringView.hpp"
+
+namespace yutiyeff
+{
+
+class Utf8String;
+class Utf16String;
+class Utf32String;
+
+// the encodings that a file can be stored in. Automatic uses the file's byte order mark (BOM) or, if it has none, UTF-8
+enum class FileEncoding
+{
+	Automatic,
+	Utf8,
+	Utf16LittleEndian,
+	Utf16BigEndian,
+	Utf32LittleEndian,
+	Utf32BigEndian,
+};
+
+// a file that is mapped (read-only) into memory instead of being read into a string.
+// its contents can be viewed without copying (when the view's encoding and byte order are the file's) or converted directly into any string type
+class MappedFile
+{
+public:
+	MappedFile() = default;
+	explicit MappedFile(const std::string& filename, FileEncoding encoding = FileEncoding::Automatic);
+	MappedFile(MappedFile&& mappedFile) noexcept;
+	MappedFile& operator=(MappedFile&& mappedFile) noexcept;
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	~MappedFile();
+
+	bool open(const std::string& filename, FileEncoding encoding = FileEncoding::Automatic); // returns false (and is then closed) if the file cannot be mapped
+	void close();
+	bool isOpen() const { return m_isOpen; }
+	FileEncoding getEncoding() const { return m_encoding; } // the encoding being used (never Automatic while open)
+
+	// the contents (without any BOM). empty if the file is in a different encoding (or byte order)
+	Utf8StringView getUtf8View() const;
+	Utf16StringView getUtf16View() const;
+	Utf32StringView getUtf32View() const;
+
+	// the contents (without any BOM) copied or converted into a string with the error policy applied (as with fromSequence; the error offset is in
+	// code units of the contents). a file that ends part way through a code unit has an invalid part there (that its view leaves out).
+	// converted strings are measured first so that they are only allocated once
+	Utf8String getUtf8String(ErrorPolicy errorPolicy = ErrorPolicy::Replace, std::size_t* errorOffset = nullptr) const;
+	Utf16String getUtf16String(ErrorPolicy errorPolicy = ErrorPolicy::Replace, std::size_t* errorOffset = nullptr) const;
+	Utf32String getUtf32String(ErrorPolicy errorPolicy = ErrorPolicy::Replace, std::size_t* errorOffset = nullptr) const;
+
+private:
+	const unsigned char* m_mapping{ nullptr };
+	std::size_t m_mappingSize{ 0u };
+	std::size_t m_bomSize{ 0u };
+	FileEncoding m_encoding{ FileEncoding::Automatic };
+	bool m_isOpen{ false };
+
+	template <class CharT>
+	StringView<CharT> priv_view(FileEncoding encoding) const;
+	template <class OutT>
+	std::basic_string<OutT> priv_sequence(ErrorPolicy errorPolicy, std::size_t* errorOffset) const;
+	template <class OutT, class InT>
+	std::basic_string<OutT> priv_unitSequence(bool isByteSwapped, ErrorPolicy errorPolicy, std::size_t* errorOffset) const; // UTF-16 or UTF-32
+};
+
+} // namespace yutiyeff
@@ -0,0 +1,420 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Yutiyeff (https://github.com/Hapaxia/Yutiyeff)
+//
+// Copyright(c) 2023-2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include "MappedFile.hpp"
+#include "Kernels.inl"
+#include "Simd.inl"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#define YUTIYEFF_UNDEFINE_WIN32_LEAN_AND_MEAN
+#endif // WIN32_LEAN_AND_MEAN
+#ifndef NOMINMAX
+#define NOMINMAX
+#define YUTIYEFF_UNDEFINE_NOMINMAX
+#endif // NOMINMAX
+#include <windows.h>
+#ifdef YUTIYEFF_UNDEFINE_WIN32_LEAN_AND_MEAN
+#undef WIN32_LEAN_AND_MEAN
+#undef YUTIYEFF_UNDEFINE_WIN32_LEAN_AND_MEAN
+#endif // YUTIYEFF_UNDEFINE_WIN32_LEAN_AND_MEAN
+#ifdef YUTIYEFF_UNDEFINE_NOMINMAX
+#undef NOMINMAX
+#undef YUTIYEFF_UNDEFINE_NOMINMAX
+#endif // YUTIYEFF_UNDEFINE_NOMINMAX
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // _WIN32
+
+namespace yutiyeff
+{
+
+namespace priv
+{
+
+inline bool isLittleEndian()
+{
+	const std::uint16_t value{ 1u };
+	unsigned char firstByte;
+	std::memcpy(&firstByte, &value, 1u);
+	return firstByte == 1u;
+}
+
+inline char byteSwapped(const char unit) { return unit; }
+inline char16_t byteSwapped(const char16_t unit) { return static_cast<char16_t>((unit >> 8) | (unit << 8)); }
+inline char32_t byteSwapped(const char32_t unit) { return (unit >> 24) | ((unit >> 8) & 0xFF00) | ((unit << 8) & 0xFF0000) | (unit << 24); }
+
+// the encoding given by the byte order mark (BOM) at the start of a file (and the size of the BOM) or Automatic if there is none
+inline FileEncoding encodingFromBom(const unsigned char* const data, const std::size_t size, std::size_t& bomSize)
+{
+	const unsigned char utf8Bom[]{ 0xEF, 0xBB, 0xBF };
+	const unsigned char utf16LittleEndianBom[]{ 0xFF, 0xFE };
+	const unsigned char utf16BigEndianBom[]{ 0xFE, 0xFF };
+	const unsigned char utf32LittleEndianBom[]{ 0xFF, 0xFE, 0x00, 0x00 };
+	const unsigned char utf32BigEndianBom[]{ 0x00, 0x00, 0xFE, 0xFF };
+
+	// UTF-32 little endian is checked before UTF-16 little endian as it starts with the same bytes
+	bomSize = 4u;
+	if ((size >= 4u) && (std::memcmp(data, utf32LittleEndianBom, 4u) == 0))
+		return FileEncoding::Utf32LittleEndian;
+	if ((size >= 4u) && (std::memcmp(data, utf32BigEndianBom, 4u) == 0))
+		return FileEncoding::Utf32BigEndian;
+	bomSize = 3u;
+	if ((size >= 3u) && (std::memcmp(data, utf8Bom, 3u) == 0))
+		return FileEncoding::Utf8;
+	bomSize = 2u;
+	if ((size >= 2u) && (std::memcmp(data, utf16LittleEndianBom, 2u) == 0))
+		return FileEncoding::Utf16LittleEndian;
+	if ((size >= 2u) && (std::memcmp(data, utf16BigEndianBom, 2u) == 0))
+		return FileEncoding::Utf16BigEndian;
+	bomSize = 0u;
+	return FileEncoding::Automatic;
+}
+
+// swaps the byte order of a sequence into "chunk" (which has room for "chunkSize" and a code point more) a chunk at a time and calls "process" with each chunk.
+// a code point that is cut off by the end of a chunk is carried into the next chunk so only the last chunk can end part way through one.
+// stops (and returns false) if "process" returns false
+template <class InT, class Process>
+inline bool forEachSwappedChunk(const InT* in, const InT* const end, InT* const chunk, const std::size_t chunkSize, const Process& process)
+{
+	const std::size_t maxSequenceLength{ 4u / sizeof(InT) };
+	std::size_t carriedSize{ 0u };
+	while (in != end)
+	{
+		const std::size_t size{ std::min(static_cast<std::size_t>(end - in), chunkSize) };
+		for (std::size_t i{ 0u }; i < size; ++i)
+			chunk[carriedSize + i] = byteSwapped(*in++);
+		InT* const chunkEnd{ chunk + carriedSize + size };
+
+		// the last code point is carried if it is not complete (it can only start in the last few code units)
+		InT* split{ chunkEnd };
+		for (InT* current{ chunkEnd }; (in != end) && (current != chunk) && (static_cast<std::size_t>(chunkEnd - current) < maxSequenceLength);)
+		{
+			if (isCodePointStart(*--current))
+			{
+				if (sequenceLength(*current) > static_cast<std::size_t>(chunkEnd - current))
+					split = current;
+				break;
+			}
+		}
+		if (!process(static_cast<const InT*>(chunk), static_cast<const InT*>(split)))
+			return false;
+		carriedSize = static_cast<std::size_t>(chunkEnd - split);
+		std::copy(split, chunkEnd, chunk);
+	}
+	return true;
+}
+
+// a file's sequence (that is already in the output encoding) with the error policy applied
+template <class CharT>
+inline std::basic_string<CharT> sequenceFromFile(const CharT* in, const CharT* const end, const bool isByteSwapped, const ErrorPolicy errorPolicy, std::size_t* const errorOffset, CharT)
+{
+	if (!isByteSwapped)
+		return validSequence<CharT>(in, end, errorPolicy, errorOffset);
+
+	std::basic_string<CharT> result(in, end);
+	for (CharT& unit : result)
+		unit = byteSwapped(unit);
+	return validSequence(std::move(result), errorPolicy, errorOffset);
+}
+
+// a file's sequence converted into the output encoding with the error policy applied
+template <class OutT, class InT>
+inline std::basic_string<OutT> sequenceFromFile(const InT* in, const InT* const end, const bool isByteSwapped, const ErrorPolicy errorPolicy, std::size_t* const errorOffset, OutT)
+{
+	if (!isByteSwapped)
+		return validSequence<OutT>(in, end, errorPolicy, errorOffset);
+
+	// the file is in the other byte order so it is swapped, checked and measured a chunk at a time and then swapped again and converted
+	// into a result that is allocated once. only a file with an invalid part is swapped whole (into a copy) to be repaired
+	const std::size_t chunkSize{ 4096u };
+	InT chunk[chunkSize + 4u / sizeof(InT)];
+	std::size_t length{ 0u };
+	const bool isChecked{ errorPolicy != ErrorPolicy::AssumeValid };
+	const bool isValid{ forEachSwappedChunk(in, end, chunk, chunkSize, [&length, isChecked](const InT* const chunkBegin, const InT* const chunkEnd) -> bool
+	{
+		if (isChecked && (findInvalid(chunkBegin, chunkEnd) != chunkEnd))
+			return false;
+		length += convertedLength(chunkBegin, chunkEnd, OutT{});
+		return true;
+	}) };
+	if (!isValid)
+	{
+		std::basic_string<InT> swapped(in, end);
+		for (InT& unit : swapped)
+			unit = byteSwapped(unit);
+		return validSequence<OutT>(swapped.data(), swapped.data() + swapped.size(), errorPolicy, errorOffset);
+	}
+	if (errorOffset != nullptr)
+		*errorOffset = std::basic_string<InT>::npos;
+
+	std::basic_string<OutT> result(length + kernelOverrun<OutT>(), OutT{});
+	OutT* out{ &result[0] };
+	forEachSwappedChunk(in, end, chunk, chunkSize, [&out](const InT* const chunkBegin, const InT* const chunkEnd) -> bool
+	{
+		out = transcodeOrCopy(chunkBegin, chunkEnd, out);
+		return true;
+	});
+	result.resize(static_cast<std::size_t>(out - result.data()));
+	countTranscode<OutT, InT>(static_cast<std::size_t>(end - in));
+	countAllocation(result);
+	return result;
+}
+
+// a file whose size is not a whole number of code units ends with part of one, which is an invalid part after the rest of its sequence
+// (at "offset", in code units). the rest of the sequence has already had the error policy applied
+template <class CharT>
+inline void endWithPartialUnit(std::basic_string<CharT>& sequence, const std::size_t offset, const ErrorPolicy errorPolicy, std::size_t* const errorOffset)
+{
+	if (errorPolicy == ErrorPolicy::AssumeValid)
+		return;
+	if ((errorOffset != nullptr) && (*errorOffset == std::basic_string<CharT>::npos))
+		*errorOffset = offset;
+	if (errorPolicy == ErrorPolicy::Throw)
+		throw InvalidSequence(offset);
+	if (errorPolicy == ErrorPolicy::Stop)
+		sequence.clear();
+	else if (errorPolicy == ErrorPolicy::Replace)
+	{
+		CharT replacement[4];
+		CharT* replacementEnd{ replacement };
+		encode(0xFFFD, replacementEnd);
+		sequence.append(replacement, replacementEnd);
+	}
+}
+
+} // namespace priv
+
+inline MappedFile::MappedFile(const std::string& filename, const FileEncoding encoding)
+{
+	open(filename, encoding);
+}
+
+inline MappedFile::MappedFile(MappedFile&& mappedFile) noexcept
+	: m_mapping{ mappedFile.m_mapping }
+	, m_mappingSize{ mappedFile.m_mappingSize }
+	, m_bomSize{ mappedFile.m_bomSize }
+	, m_encoding{ mappedFile.m_encoding }
+	, m_isOpen{ mappedFile.m_isOpen }
+{
+	mappedFile.m_mapping = nullptr;
+	mappedFile.m_isOpen = false;
+	mappedFile.close();
+}
+
+inline MappedFile& MappedFile::operator=(MappedFile&& mappedFile) noexcept
+{
+	if (&mappedFile == this)
+		return *this;
+	close();
+	std::swap(m_mapping, mappedFile.m_mapping);
+	std::swap(m_mappingSize, mappedFile.m_mappingSize);
+	std::swap(m_bomSize, mappedFile.m_bomSize);
+	std::swap(m_encoding, mappedFile.m_encoding);
+	std::swap(m_isOpen, mappedFile.m_isOpen);
+	return *this;
+}
+
+inline MappedFile::~MappedFile()
+{
+	close();
+}
+
+inline bool MappedFile::open(const std::string& filename, const FileEncoding encoding)
+{
+	close();
+
+	// an empty file is not mapped (but is still open)
+	const void* mapping{ nullptr };
+	std::size_t size{ 0u };
+#ifdef _WIN32
+	const HANDLE file{ CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr) };
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize))
+	{
+		CloseHandle(file);
+		return false;
+	}
+	size = static_cast<std::size_t>(fileSize.QuadPart);
+	if (size != 0u)
+	{
+		const HANDLE fileMapping{ CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) };
+		if (fileMapping != nullptr)
+		{
+			mapping = MapViewOfFile(fileMapping, FILE_MAP_READ, 0, 0, 0);
+			CloseHandle(fileMapping); // the view keeps the mapping open
+		}
+	}
+	CloseHandle(file);
+#else
+	const int file{ ::open(filename.c_str(), O_RDONLY) };
+	if (file == -1)
+		return false;
+	struct stat status;
+	if (::fstat(file, &status) != 0)
+	{
+		::close(file);
+		return false;
+	}
+	size = static_cast<std::size_t>(status.st_size);
+	if (size != 0u)
+	{
+		mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+		if (mapping == MAP_FAILED)
+			mapping = nullptr;
+	}
+	::close(file); // the mapping stays valid after the file is closed
+#endif // _WIN32
+	if ((size != 0u) && (mapping == nullptr))
+		return false;
+
+	m_mapping = static_cast<const unsigned char*>(mapping);
+	m_mappingSize = size;
+	m_isOpen = true;
+
+	std::size_t bomSize;
+	const FileEncoding bomEncoding{ priv::encodingFromBom(m_mapping, m_mappingSize, bomSize) };
+	if (encoding == FileEncoding::Automatic)
+	{
+		m_encoding = (bomEncoding == FileEncoding::Automatic) ? FileEncoding::Utf8 : bomEncoding;
+		m_bomSize = bomSize;
+	}
+	else
+	{
+		m_encoding = encoding;
+		m_bomSize = (bomEncoding == encoding) ? bomSize : 0u;
+	}
+	return true;
+}
+
+inline void MappedFile::close()
+{
+	if (m_mapping != nullptr)
+	{
+#ifdef _WIN32
+		UnmapViewOfFile(m_mapping);
+#else
+		::munmap(const_cast<unsigned char*>(m_mapping), m_mappingSize);
+#endif // _WIN32
+	}
+	m_mapping = nullptr;
+	m_mappingSize = 0u;
+	m_bomSize = 0u;
+	m_encoding = FileEncoding::Automatic;
+	m_isOpen = false;
+}
+
+inline Utf8StringView MappedFile::getUtf8View() const
+{
+	return priv_view<char>(FileEncoding::Utf8);
+}
+
+inline Utf16StringView MappedFile::getUtf16View() const
+{
+	return priv_view<char16_t>(priv::isLittleEndian() ? FileEncoding::Utf16LittleEndian : FileEncoding::Utf16BigEndian);
+}
+
+inline Utf32StringView MappedFile::getUtf32View() const
+{
+	return priv_view<char32_t>(priv::isLittleEndian() ? FileEncoding::Utf32LittleEndian : FileEncoding::Utf32BigEndian);
+}
+
+inline Utf8String MappedFile::getUtf8String(const ErrorPolicy errorPolicy, std::size_t* const errorOffset) const
+{
+	return Utf8String::fromSequence(priv_sequence<char>(errorPolicy, errorOffset), ErrorPolicy::AssumeValid); // already checked
+}
+
+inline Utf16String MappedFile::getUtf16String(const ErrorPolicy errorPolicy, std::size_t* const errorOffset) const
+{
+	return Utf16String::fromSequence(priv_sequence<char16_t>(errorPolicy, errorOffset), ErrorPolicy::AssumeValid); // already checked
+}
+
+inline Utf32String MappedFile::getUtf32String(const ErrorPolicy errorPolicy, std::size_t* const errorOffset) const
+{
+	return Utf32String::fromSequence(priv_sequence<char32_t>(errorPolicy, errorOffset), ErrorPolicy::AssumeValid); // already checked
+}
+
+template <class CharT>
+inline StringView<CharT> MappedFile::priv_view(const FileEncoding encoding) const
+{
+	if (m_encoding != encoding)
+		return StringView<CharT>();
+	return StringView<CharT>(reinterpret_cast<const CharT*>(m_mapping + m_bomSize), (m_mappingSize - m_bomSize) / sizeof(CharT));
+}
+
+template <class OutT>
+inline std::basic_string<OutT> MappedFile::priv_sequence(const ErrorPolicy errorPolicy, std::size_t* const errorOffset) const
+{
+	if (errorOffset != nullptr)
+		*errorOffset = std::basic_string<OutT>::npos;
+	const unsigned char* const data{ m_mapping + m_bomSize };
+	const std::size_t dataSize{ m_mappingSize - m_bomSize };
+	const bool isLittleEndian{ priv::isLittleEndian() };
+	switch (m_encoding)
+	{
+	case FileEncoding::Utf8:
+		return priv::sequenceFromFile(reinterpret_cast<const char*>(data), reinterpret_cast<const char*>(data) + dataSize, false, errorPolicy, errorOffset, OutT{});
+	case FileEncoding::Utf16LittleEndian:
+	case FileEncoding::Utf16BigEndian:
+		return priv_unitSequence<OutT, char16_t>(isLittleEndian != (m_encoding == FileEncoding::Utf16LittleEndian), errorPolicy, errorOffset);
+	case FileEncoding::Utf32LittleEndian:
+	case FileEncoding::Utf32BigEndian:
+		return priv_unitSequence<OutT, char32_t>(isLittleEndian != (m_encoding == FileEncoding::Utf32LittleEndian), errorPolicy, errorOffset);
+	default:
+		return std::basic_string<OutT>();
+	}
+}
+
+template <class OutT, class InT>
+inline std::basic_string<OutT> MappedFile::priv_unitSequence(const bool isByteSwapped, const ErrorPolicy errorPolicy, std::size_t* const errorOffset) const
+{
+	// any bytes after the last whole code unit are the start of a code unit that the file is missing
+	const std::size_t dataSize{ m_mappingSize - m_bomSize };
+	const std::size_t unitCount{ dataSize / sizeof(InT) };
+	const InT* const in{ reinterpret_cast<const InT*>(m_mapping + m_bomSize) };
+	std::basic_string<OutT> sequence{ priv::sequenceFromFile(in, in + unitCount, isByteSwapped, errorPolicy, errorOffset, OutT{}) };
+	if ((dataSize % sizeof(InT)) != 0u)
+		priv::endWithPartialUnit(sequence, unitCount, errorPolicy, errorOffset);
+	return sequence;
+}
+
+} // namespace yutiyeff
@@ -0,0 +1,55 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Yutiyeff (https://github.com/Hapaxia/Yutiyeff)
+//
+// Copyright(c) 2023-2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "StringView.hpp"
+
+namespace yutiyeff
+{
+
+// converts a (very large) sequence using several threads, each converting its own part of the sequence into its own part of the result.
+// the parts start at the start of code points and are converted in two passes: the threads first check and measure their parts and then,
+// once the result has been allocated (once) for the total size, convert them into place.
+// "threadCount" includes the calling thread and 0 uses std::thread::hardware_concurrency(). each thread needs a part of at least 64 KiB so
+// shorter sequences use fewer threads (and the shortest are converted by the calling thread alone).
+// the sequence is checked as it is when a string is created from it (see ErrorPolicy); one with invalid parts is repaired (or, with Throw, reported) by the calling thread alone
+template <class T, class InCharT>
+T convertInParallel(const StringView<InCharT>& sequence, unsigned int threadCount = 0u, ErrorPolicy errorPolicy = ErrorPolicy::Replace, std::size_t* errorOffset = nullptr);
+
+// the same for a Yutiyeff string, which is not checked again
+template <class T, class FromT, class FromCharT>
+T convertInParallel(const String<FromT, FromCharT>& string, unsigned int threadCount = 0u);
+
+} // namespace yutiyeff
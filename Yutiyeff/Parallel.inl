@@ -0,0 +1,216 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Yutiyeff (https://github.com/Hapaxia/Yutiyeff)
+//
+// Copyright(c) 2023-2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+
+#pragma once
+
+#include "Parallel.hpp"
+
+#include <functional>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace yutiyeff
+{
+
+namespace priv
+{
+
+// the code unit type of a string type
+template <class T, class CharT>
+CharT charTypeOf(const String<T, CharT>&);
+
+// threads that are joined when they are destroyed (so none is left running, which would terminate, if the calling thread throws)
+struct JoinedThreads
+{
+	std::vector<std::thread> threads;
+
+	~JoinedThreads()
+	{
+		for (std::thread& thread : threads)
+			thread.join();
+	}
+};
+
+// runs "job" for each part (the first on the calling thread and each of the others on its own thread) and waits for them all.
+// a part that cannot get its own thread (e.g. when the system has run out of threads) is run on the calling thread instead
+template <class Job>
+inline void runParts(const std::size_t partCount, const Job& job)
+{
+	JoinedThreads joinedThreads;
+	joinedThreads.threads.reserve(partCount - 1u);
+	std::size_t index{ 1u };
+	for (; index < partCount; ++index)
+	{
+		try
+		{
+			joinedThreads.threads.emplace_back(std::cref(job), index);
+		}
+		catch (const std::system_error&)
+		{
+			break;
+		}
+	}
+	job(0u);
+	for (; index < partCount; ++index)
+		job(index);
+}
+
+// a part of a sequence that is converted by one thread. the kernel overrun (see kernelOverrun) past the end of a part's output would be in the
+// output of the next part, so the "head" of each part (after the first) is left to be converted exactly once every thread has finished
+template <class InT>
+struct ParallelPart
+{
+	const InT* in;
+	const InT* bodyIn; // the end of the head
+	const InT* end;
+	bool isValid;
+	std::size_t headLength; // converted lengths
+	std::size_t length;
+	std::size_t offset; // of its output
+};
+
+template <class OutT, class InT>
+struct ParallelMeasure
+{
+	std::vector<ParallelPart<InT>>& parts;
+	bool isChecking;
+
+	void operator()(const std::size_t index) const
+	{
+		ParallelPart<InT>& part(parts[index]);
+		part.isValid = !isChecking || (findInvalid(part.in, part.end) == part.end);
+		if (!part.isValid)
+			return;
+		part.headLength = convertedLength(part.in, part.bodyIn, OutT{});
+		part.length = part.headLength + convertedLength(part.bodyIn, part.end, OutT{});
+	}
+};
+
+template <class OutT, class InT>
+struct ParallelConvert
+{
+	const std::vector<ParallelPart<InT>>& parts;
+	OutT* out;
+
+	void operator()(const std::size_t index) const
+	{
+		const ParallelPart<InT>& part(parts[index]);
+		transcodeOrCopy(part.bodyIn, part.end, out + part.offset + part.headLength);
+	}
+};
+
+// the parts of a sequence for up to "threadCount" threads. each starts at the start of a code point
+template <class InT>
+inline std::vector<ParallelPart<InT>> parallelParts(const InT* const in, const InT* const end, const std::size_t threadCount, const std::size_t headSize)
+{
+	const std::size_t minimumPartSize{ 65536u / sizeof(InT) };
+	const std::size_t size{ static_cast<std::size_t>(end - in) };
+	const std::size_t maximumPartCount{ (size / minimumPartSize) + 1u };
+	const std::size_t partCount{ (threadCount < maximumPartCount) ? threadCount : maximumPartCount };
+
+	std::vector<ParallelPart<InT>> parts(partCount);
+	const InT* partIn{ in };
+	for (std::size_t index{ 0u }; index < partCount; ++index)
+	{
+		const InT* partEnd{ (index == (partCount - 1u)) ? end : (in + ((size / partCount) * (index + 1u))) };
+		while ((partEnd != end) && !isCodePointStart(*partEnd))
+			++partEnd;
+		const InT* bodyIn{ partIn };
+		if (index != 0u)
+		{
+			bodyIn = ((partEnd - partIn) > static_cast<std::ptrdiff_t>(headSize)) ? (partIn + headSize) : partEnd;
+			while ((bodyIn != partEnd) && !isCodePointStart(*bodyIn))
+				++bodyIn;
+		}
+		parts[index] = ParallelPart<InT>{ partIn, bodyIn, partEnd, false, 0u, 0u, 0u };
+		partIn = partEnd;
+	}
+	return parts;
+}
+
+// converts a sequence in parallel (see convertInParallel)
+template <class OutT, class InT>
+inline std::basic_string<OutT> sequenceInParallel(const InT* const in, const InT* const end, unsigned int threadCount, const ErrorPolicy errorPolicy, std::size_t* const errorOffset)
+{
+	const StatsScope statsScope{ StatsOperation::Parallel };
+	if (errorOffset != nullptr)
+		*errorOffset = std::basic_string<InT>::npos;
+	if (threadCount == 0u)
+		threadCount = std::thread::hardware_concurrency();
+
+	// the output of a head must cover the whole overrun of the part before it, which is kernelOverrun<char>() bytes. every code unit produces at least
+	// two thirds of a byte (a 3-byte UTF-8 sequence becomes a single UTF-16 code unit) so one and a half times that many code units would be enough;
+	// twice that many (128) are used
+	const std::size_t headSize{ 2u * kernelOverrun<char>() };
+	std::vector<ParallelPart<InT>> parts{ parallelParts(in, end, (threadCount > 1u) ? threadCount : 1u, headSize) };
+	if (parts.size() < 2u)
+		return validSequence<OutT>(in, end, errorPolicy, errorOffset);
+
+	runParts(parts.size(), ParallelMeasure<OutT, InT>{ parts, errorPolicy != ErrorPolicy::AssumeValid });
+	std::size_t length{ 0u };
+	for (ParallelPart<InT>& part : parts)
+	{
+		if (!part.isValid)
+			return validSequence<OutT>(in, end, errorPolicy, errorOffset);
+		part.offset = length;
+		length += part.length;
+	}
+
+	std::basic_string<OutT> result(length + kernelOverrun<OutT>(), OutT{});
+	OutT* const out{ &result[0u] };
+	runParts(parts.size(), ParallelConvert<OutT, InT>{ parts, out });
+	for (const ParallelPart<InT>& part : parts)
+		transcodeOrCopyExactly(part.in, part.bodyIn, out + part.offset);
+	result.resize(length);
+	countTranscode<OutT, InT>(static_cast<std::size_t>(end - in));
+	countAllocation(result);
+	return result;
+}
+
+} // namespace priv
+
+template <class T, class InCharT>
+inline T convertInParallel(const StringView<InCharT>& sequence, const unsigned int threadCount, const ErrorPolicy errorPolicy, std::size_t* const errorOffset)
+{
+	using OutCharT = decltype(priv::charTypeOf(std::declval<const T&>()));
+	const InCharT* const in{ sequence.getData() };
+	return T::fromSequence(priv::sequenceInParallel<OutCharT>(in, in + sequence.getDataSize(), threadCount, errorPolicy, errorOffset), ErrorPolicy::AssumeValid);
+}
+
+template <class T, class FromT, class FromCharT>
+inline T convertInParallel(const String<FromT, FromCharT>& string, const unsigned int threadCount)
+{
+	return convertInParallel<T>(string.getView(), threadCount, ErrorPolicy::AssumeValid);
+}
+
+} // namespace yutiyeff
@@ -0,0 +1,125 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Yutiyeff (https://github.com/Hapaxia/Yutiyeff)
+//
+// Copyright(c) 2023-2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "StringView.hpp"
+
+namespace yutiyeff
+{
+
+// a string (UTF-8, UTF-16 or UTF-32, by code unit type) for large text that is edited often. the text is kept in chunks (of whole code points)
+// in a balanced tree whose nodes keep the lengths of their chunks and their subtrees in each encoding (and so in code points) so that
+// operator[], "insert", "erase" and "set" find their place in O(log n) and only change the chunks at that place.
+// as with the string types, a sequence is checked when a rope is created from it (or it is inserted) so the rope is always valid
+template <class CharT>
+class Rope
+{
+public:
+	Rope() = default;
+	template <class InCharT>
+	Rope(const InCharT* cString); // null-terminated (and not null)
+	template <class InCharT>
+	Rope(const StringView<InCharT>& view);
+	template <class T, class InCharT>
+	Rope(const String<T, InCharT>& string); // not checked again
+	Rope(const Rope& rope);
+	Rope(Rope&& rope) noexcept = default;
+
+	Rope& operator=(const Rope& rope);
+	Rope& operator=(Rope&& rope) noexcept = default;
+
+	// the whole text, converted by walking the chunks once (into a result that is allocated once, at its exact size)
+	Utf8String getUtf8String() const;
+	Utf16String getUtf16String() const;
+	Utf32String getUtf32String() const;
+	std::string getString() const; // get a standard std::string representing the UTF-8 formatted version of the rope
+	std::basic_string<CharT> getSequence() const;
+
+	std::size_t length() const { return priv_length(m_root.get(), 2u); }
+	std::size_t getDataSize() const { return priv_length(m_root.get(), m_encodingIndex); } // in code units
+	bool empty() const { return length() == 0u; }
+	std::size_t size() const { return length(); }
+
+	char32_t operator[](std::size_t index) const;
+	void insert(std::size_t offset, const StringView<CharT>& sequence);
+	void insert(std::size_t offset, char32_t char32);
+	void erase(std::size_t startPos, std::size_t length = 0u);
+	void set(std::size_t index, char32_t char32);
+	void clear() { m_root.reset(); }
+
+private:
+	// each node has a chunk and the lengths of the chunk and of its subtree (which includes its chunk) in UTF-8, UTF-16 and UTF-32 code units.
+	// the tree is a treap: in order, the chunks are the text and each node's priority is at least that of its children (which balances it)
+	struct Node
+	{
+		std::basic_string<CharT> chunk;
+		std::size_t chunkLengths[3];
+		std::size_t lengths[3];
+		std::uint32_t priority;
+		std::unique_ptr<Node> left;
+		std::unique_ptr<Node> right;
+	};
+	using NodePtr = std::unique_ptr<Node>;
+
+	static const std::size_t m_encodingIndex{ sizeof(CharT) / 2u }; // the index of this encoding in the lengths (0, 1 or 2 for 1-byte, 2-byte or 4-byte code units)
+	static const std::size_t m_maxChunkSize{ 2048u }; // in code units. chunks only grow past this by a single code point (when one is set)
+
+	NodePtr m_root;
+	std::uint32_t m_seed{ 0x9E3779B9u }; // for the priorities
+
+	static std::size_t priv_length(const Node* node, std::size_t encodingIndex) { return (node != nullptr) ? node->lengths[encodingIndex] : 0u; }
+	static void priv_measure(Node& node); // after its chunk changes
+	static void priv_update(Node& node); // after its chunk or its children change
+	static NodePtr priv_copy(const Node* node);
+	static NodePtr priv_merge(NodePtr left, NodePtr right);
+	template <class OutT>
+	static OutT* priv_convertChunks(const Node* node, OutT* out);
+	NodePtr priv_newNode(const CharT* in, const CharT* end);
+	void priv_split(NodePtr node, std::size_t index, NodePtr& left, NodePtr& right); // into the first "index" code points and the rest
+	NodePtr priv_build(const CharT* in, const CharT* end); // a tree of chunks of (valid) sequence
+	bool priv_insertInPlace(Node* node, std::size_t index, const CharT* in, const CharT* end); // into an existing chunk (if it has room)
+	bool priv_eraseInPlace(Node* node, std::size_t index, std::size_t length); // from an existing chunk (if the code points are all in it)
+	void priv_setInPlace(Node* node, std::size_t index, const CharT* in, const CharT* end); // replaces the code point at "index" with a (valid) sequence
+	template <class OutT>
+	std::basic_string<OutT> priv_sequence() const;
+};
+
+using Utf8Rope = Rope<char>;
+using Utf16Rope = Rope<char16_t>;
+using Utf32Rope = Rope<char32_t>;
+
+} // namespace yutiyeff
@@ -0,0 +1,428 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Yutiyeff (https://github.com/Hapaxia/Yutiyeff)
+//
+// Copyright(c) 2023-2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+
+#pragma once
+
+#include "Rope.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+namespace yutiyeff
+{
+
+template <class CharT>
+const std::size_t Rope<CharT>::m_encodingIndex;
+
+template <class CharT>
+const std::size_t Rope<CharT>::m_maxChunkSize;
+
+template <class CharT>
+template <class InCharT>
+inline Rope<CharT>::Rope(const InCharT* const cString)
+	: Rope(StringView<InCharT>(cString))
+{
+}
+
+template <class CharT>
+template <class InCharT>
+inline Rope<CharT>::Rope(const StringView<InCharT>& view)
+{
+	const std::basic_string<CharT> sequence{ priv::validSequence<CharT>(view.getData(), view.getData() + view.getDataSize()) };
+	m_root = priv_build(sequence.data(), sequence.data() + sequence.size());
+}
+
+template <class CharT>
+template <class T, class InCharT>
+inline Rope<CharT>::Rope(const String<T, InCharT>& string)
+{
+	const StringView<InCharT> view{ string.getView() };
+	const std::basic_string<CharT> sequence{ priv::sequenceOf(view.getData(), view.getData() + view.getDataSize(), CharT{}) };
+	m_root = priv_build(sequence.data(), sequence.data() + sequence.size());
+}
+
+template <class CharT>
+inline Rope<CharT>::Rope(const Rope& rope)
+	: m_root{ priv_copy(rope.m_root.get()) }
+	, m_seed{ rope.m_seed }
+{
+}
+
+template <class CharT>
+inline Rope<CharT>& Rope<CharT>::operator=(const Rope& rope)
+{
+	if (&rope != this)
+		m_root = priv_copy(rope.m_root.get());
+	return *this;
+}
+
+template <class CharT>
+inline Utf8String Rope<CharT>::getUtf8String() const
+{
+	return Utf8String::fromSequence(priv_sequence<char>(), ErrorPolicy::AssumeValid);
+}
+
+template <class CharT>
+inline Utf16String Rope<CharT>::getUtf16String() const
+{
+	return Utf16String::fromSequence(priv_sequence<char16_t>(), ErrorPolicy::AssumeValid);
+}
+
+template <class CharT>
+inline Utf32String Rope<CharT>::getUtf32String() const
+{
+	return Utf32String::fromSequence(priv_sequence<char32_t>(), ErrorPolicy::AssumeValid);
+}
+
+template <class CharT>
+inline std::string Rope<CharT>::getString() const
+{
+	return priv_sequence<char>();
+}
+
+template <class CharT>
+inline std::basic_string<CharT> Rope<CharT>::getSequence() const
+{
+	return priv_sequence<CharT>();
+}
+
+template <class CharT>
+inline char32_t Rope<CharT>::operator[](std::size_t index) const
+{
+	const Node* node{ m_root.get() };
+	while (node != nullptr)
+	{
+		const std::size_t leftLength{ priv_length(node->left.get(), 2u) };
+		if (index < leftLength)
+			node = node->left.get();
+		else if (index < (leftLength + node->chunkLengths[2u]))
+		{
+			const CharT* const begin{ node->chunk.data() };
+			return priv::validCodePointAt(priv::findCodePoint(begin, begin + node->chunk.size(), index - leftLength));
+		}
+		else
+		{
+			index -= leftLength + node->chunkLengths[2u];
+			node = node->right.get();
+		}
+	}
+	return 0u;
+}
+
+template <class CharT>
+inline void Rope<CharT>::insert(const std::size_t offset, const StringView<CharT>& sequence)
+{
+	if (offset > length()) // as with the string types
+		throw std::out_of_range("yutiyeff: insert offset is past the end of the rope");
+	const CharT* in{ sequence.getData() };
+	const CharT* end{ in + sequence.getDataSize() };
+	std::basic_string<CharT> repaired;
+	const CharT* const invalid{ priv::findInvalid(in, end) };
+	if (invalid != end)
+	{
+		repaired = priv::repairedSequence(in, end, invalid, true);
+		in = repaired.data();
+		end = in + repaired.size();
+	}
+	if (in == end)
+		return;
+
+	if (priv_insertInPlace(m_root.get(), offset, in, end))
+		return;
+	NodePtr left;
+	NodePtr right;
+	priv_split(std::move(m_root), offset, left, right);
+	m_root = priv_merge(priv_merge(std::move(left), priv_build(in, end)), std::move(right));
+}
+
+template <class CharT>
+inline void Rope<CharT>::insert(const std::size_t offset, const char32_t char32)
+{
+	CharT encoded[4];
+	CharT* encodedEnd{ encoded };
+	if (priv::isValidCodePoint(char32)) // otherwise discarded (once the offset is checked), as it is by the string types
+		priv::encode(char32, encodedEnd);
+	insert(offset, StringView<CharT>(encoded, static_cast<std::size_t>(encodedEnd - encoded)));
+}
+
+template <class CharT>
+inline void Rope<CharT>::erase(const std::size_t startPos, std::size_t length)
+{
+	const std::size_t ropeLength{ this->length() };
+	if (startPos >= ropeLength)
+		return;
+	if ((length == 0u) || (length > (ropeLength - startPos)))
+		length = ropeLength - startPos;
+	if (priv_eraseInPlace(m_root.get(), startPos, length))
+		return;
+	NodePtr left;
+	NodePtr rest;
+	NodePtr erased;
+	NodePtr right;
+	priv_split(std::move(m_root), startPos, left, rest);
+	priv_split(std::move(rest), length, erased, right);
+	m_root = priv_merge(std::move(left), std::move(right));
+}
+
+template <class CharT>
+inline void Rope<CharT>::set(const std::size_t index, const char32_t char32)
+{
+	if (index >= length())
+		return;
+	if (!priv::isValidCodePoint(char32)) // the code point could not be encoded so it is removed (as it is by the string types)
+	{
+		erase(index, 1u);
+		return;
+	}
+	CharT encoded[4];
+	CharT* encodedEnd{ encoded };
+	priv::encode(char32, encodedEnd);
+	priv_setInPlace(m_root.get(), index, encoded, encodedEnd);
+}
+
+template <class CharT>
+inline void Rope<CharT>::priv_measure(Node& node)
+{
+	const CharT* const begin{ node.chunk.data() };
+	const CharT* const end{ begin + node.chunk.size() };
+	node.chunkLengths[0u] = priv::convertedLength(begin, end, char{});
+	node.chunkLengths[1u] = priv::convertedLength(begin, end, char16_t{});
+	node.chunkLengths[2u] = priv::convertedLength(begin, end, char32_t{});
+}
+
+template <class CharT>
+inline void Rope<CharT>::priv_update(Node& node)
+{
+	for (std::size_t encodingIndex{ 0u }; encodingIndex < 3u; ++encodingIndex)
+		node.lengths[encodingIndex] = priv_length(node.left.get(), encodingIndex) + node.chunkLengths[encodingIndex] + priv_length(node.right.get(), encodingIndex);
+}
+
+template <class CharT>
+inline typename Rope<CharT>::NodePtr Rope<CharT>::priv_copy(const Node* const node)
+{
+	if (node == nullptr)
+		return NodePtr();
+	NodePtr copy{ new Node{ node->chunk, { }, { }, node->priority, priv_copy(node->left.get()), priv_copy(node->right.get()) } };
+	for (std::size_t encodingIndex{ 0u }; encodingIndex < 3u; ++encodingIndex)
+	{
+		copy->chunkLengths[encodingIndex] = node->chunkLengths[encodingIndex];
+		copy->lengths[encodingIndex] = node->lengths[encodingIndex];
+	}
+	return copy;
+}
+
+template <class CharT>
+inline typename Rope<CharT>::NodePtr Rope<CharT>::priv_merge(NodePtr left, NodePtr right)
+{
+	if (!left)
+		return right;
+	if (!right)
+		return left;
+	if (left->priority >= right->priority)
+	{
+		left->right = priv_merge(std::move(left->right), std::move(right));
+		priv_update(*left);
+		return left;
+	}
+	right->left = priv_merge(std::move(left), std::move(right->left));
+	priv_update(*right);
+	return right;
+}
+
+template <class CharT>
+template <class OutT>
+inline OutT* Rope<CharT>::priv_convertChunks(const Node* const node, OutT* out)
+{
+	if (node == nullptr)
+		return out;
+	out = priv_convertChunks(node->left.get(), out);
+	out = priv::transcodeOrCopy(node->chunk.data(), node->chunk.data() + node->chunk.size(), out);
+	return priv_convertChunks(node->right.get(), out);
+}
+
+template <class CharT>
+inline typename Rope<CharT>::NodePtr Rope<CharT>::priv_newNode(const CharT* const in, const CharT* const end)
+{
+	// xorshift
+	m_seed ^= m_seed << 13u;
+	m_seed ^= m_seed >> 17u;
+	m_seed ^= m_seed << 5u;
+	NodePtr node{ new Node{ std::basic_string<CharT>(in, end), { }, { }, m_seed, NodePtr(), NodePtr() } };
+	priv_measure(*node);
+	priv_update(*node);
+	return node;
+}
+
+template <class CharT>
+inline void Rope<CharT>::priv_split(NodePtr node, const std::size_t index, NodePtr& left, NodePtr& right)
+{
+	if (!node)
+	{
+		left.reset();
+		right.reset();
+		return;
+	}
+	const std::size_t leftLength{ priv_length(node->left.get(), 2u) };
+	const std::size_t chunkLength{ node->chunkLengths[2u] };
+	if (index <= leftLength)
+	{
+		priv_split(std::move(node->left), index, left, node->left);
+		priv_update(*node);
+		right = std::move(node);
+	}
+	else if (index >= (leftLength + chunkLength))
+	{
+		priv_split(std::move(node->right), index - leftLength - chunkLength, node->right, right);
+		priv_update(*node);
+		left = std::move(node);
+	}
+	else // the chunk itself is split: its end becomes a new node at the start of the right part
+	{
+		const CharT* const begin{ node->chunk.data() };
+		const CharT* const end{ begin + node->chunk.size() };
+		const CharT* const middle{ priv::findCodePoint(begin, end, index - leftLength) };
+		NodePtr tail{ priv_newNode(middle, end) };
+		node->chunk.resize(static_cast<std::size_t>(middle - begin));
+		priv_measure(*node);
+		right = priv_merge(std::move(tail), std::move(node->right));
+		priv_update(*node);
+		left = std::move(node);
+	}
+}
+
+template <class CharT>
+inline typename Rope<CharT>::NodePtr Rope<CharT>::priv_build(const CharT* in, const CharT* const end)
+{
+	NodePtr root;
+	while (in != end)
+	{
+		const CharT* chunkEnd{ ((end - in) > static_cast<std::ptrdiff_t>(m_maxChunkSize)) ? (in + m_maxChunkSize) : end };
+		while ((chunkEnd != end) && !priv::isCodePointStart(*chunkEnd))
+			--chunkEnd;
+		root = priv_merge(std::move(root), priv_newNode(in, chunkEnd));
+		in = chunkEnd;
+	}
+	return root;
+}
+
+template <class CharT>
+inline bool Rope<CharT>::priv_insertInPlace(Node* const node, const std::size_t index, const CharT* const in, const CharT* const end)
+{
+	if (node == nullptr)
+		return false;
+	const std::size_t leftLength{ priv_length(node->left.get(), 2u) };
+	bool isInserted;
+	if (index < leftLength)
+		isInserted = priv_insertInPlace(node->left.get(), index, in, end);
+	else if (index <= (leftLength + node->chunkLengths[2u]))
+	{
+		isInserted = (node->chunk.size() + static_cast<std::size_t>(end - in)) <= m_maxChunkSize;
+		if (isInserted)
+		{
+			const CharT* const begin{ node->chunk.data() };
+			const std::size_t offset{ static_cast<std::size_t>(priv::findCodePoint(begin, begin + node->chunk.size(), index - leftLength) - begin) };
+			node->chunk.insert(offset, in, static_cast<std::size_t>(end - in));
+			priv_measure(*node);
+		}
+	}
+	else
+		isInserted = priv_insertInPlace(node->right.get(), index - leftLength - node->chunkLengths[2u], in, end);
+	if (isInserted)
+		priv_update(*node);
+	return isInserted;
+}
+
+template <class CharT>
+inline bool Rope<CharT>::priv_eraseInPlace(Node* const node, const std::size_t index, const std::size_t length)
+{
+	if (node == nullptr)
+		return false;
+	const std::size_t leftLength{ priv_length(node->left.get(), 2u) };
+	bool isErased;
+	if (index < leftLength)
+		isErased = priv_eraseInPlace(node->left.get(), index, length);
+	else if (index < (leftLength + node->chunkLengths[2u]))
+	{
+		isErased = (index + length) <= (leftLength + node->chunkLengths[2u]);
+		if (isErased)
+		{
+			const CharT* const begin{ node->chunk.data() };
+			const CharT* const end{ begin + node->chunk.size() };
+			const CharT* const first{ priv::findCodePoint(begin, end, index - leftLength) };
+			const CharT* const last{ priv::findCodePoint(first, end, length) };
+			node->chunk.erase(static_cast<std::size_t>(first - begin), static_cast<std::size_t>(last - first));
+			priv_measure(*node);
+		}
+	}
+	else
+		isErased = priv_eraseInPlace(node->right.get(), index - leftLength - node->chunkLengths[2u], length);
+	if (isErased)
+		priv_update(*node);
+	return isErased;
+}
+
+template <class CharT>
+inline void Rope<CharT>::priv_setInPlace(Node* const node, const std::size_t index, const CharT* const in, const CharT* const end)
+{
+	const std::size_t leftLength{ priv_length(node->left.get(), 2u) };
+	if (index < leftLength)
+		priv_setInPlace(node->left.get(), index, in, end);
+	else if (index < (leftLength + node->chunkLengths[2u]))
+	{
+		const CharT* const begin{ node->chunk.data() };
+		const CharT* const chunkEnd{ begin + node->chunk.size() };
+		const CharT* const first{ priv::findCodePoint(begin, chunkEnd, index - leftLength) };
+		const CharT* const last{ priv::findCodePoint(first, chunkEnd, 1u) };
+		node->chunk.replace(static_cast<std::size_t>(first - begin), static_cast<std::size_t>(last - first), in, static_cast<std::size_t>(end - in));
+		priv_measure(*node);
+	}
+	else
+		priv_setInPlace(node->right.get(), index - leftLength - node->chunkLengths[2u], in, end);
+	priv_update(*node);
+}
+
+template <class CharT>
+template <class OutT>
+inline std::basic_string<OutT> Rope<CharT>::priv_sequence() const
+{
+	// the chunks are converted in order so the kernel overrun past each one is only ever written into room that the next chunk has not used yet
+	// (and there is room for it after the last one)
+	const priv::StatsScope statsScope{ StatsOperation::Rope };
+	const std::size_t length{ priv_length(m_root.get(), sizeof(OutT) / 2u) };
+	std::basic_string<OutT> result(length + priv::kernelOverrun<OutT>(), OutT{});
+	priv_convertChunks(m_root.get(), &result[0u]);
+	result.resize(length);
+	priv::countTranscode<OutT, CharT>(getDataSize());
+	priv::countAllocation(result);
+	return result;
+}
+
+} // namespace yutiyeff
@@ -0,0 +1,1549 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Yutiyeff (https://github.com/Hapaxia/Yutiyeff)
+//
+// Copyright(c) 2023-2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+
+#ifdef YUTIYEFF_SIMD_X86
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define YUTIYEFF_TARGET_SSE42
+#define YUTIYEFF_TARGET_AVX2
+#define YUTIYEFF_TARGET_AVX512
+#else
+#include <immintrin.h>
+#define YUTIYEFF_TARGET_SSE42 __attribute__((target("sse4.2")))
+#define YUTIYEFF_TARGET_AVX2 __attribute__((target("avx2")))
+#define YUTIYEFF_TARGET_AVX512 __attribute__((target("avx512f,avx512bw,avx512vl")))
+#endif // _MSC_VER
+#endif // YUTIYEFF_SIMD_X86
+
+namespace yutiyeff
+{
+
+namespace priv
+{
+
+#ifdef YUTIYEFF_SIMD_X86
+
+// CPU FEATURES
+
+struct CpuFeatures
+{
+	bool sse42;
+	bool avx2;
+	bool avx512;
+};
+
+inline CpuFeatures detectCpuFeatures()
+{
+	CpuFeatures features{ false, false, false };
+#if defined(_MSC_VER) && !defined(__clang__)
+	int info[4];
+	__cpuid(info, 0);
+	const int highestFunction{ info[0] };
+	__cpuid(info, 1);
+	features.sse42 = (info[2] & (1 << 20)) != 0;
+	const bool osSavesAvx{ ((info[2] & (1 << 27)) != 0) && ((info[2] & (1 << 28)) != 0) && ((_xgetbv(0) & 0x06) == 0x06) };
+	if (osSavesAvx && (highestFunction >= 7))
+	{
+		const bool osSavesAvx512{ (_xgetbv(0) & 0xE6) == 0xE6 };
+		__cpuidex(info, 7, 0);
+		features.avx2 = (info[1] & (1 << 5)) != 0;
+		features.avx512 = osSavesAvx512 && ((info[1] & (1 << 16)) != 0) && ((info[1] & (1 << 30)) != 0) && ((info[1] & (1 << 31)) != 0);
+	}
+#else
+	__builtin_cpu_init(); // needed if this is called during static initialisation
+	features.sse42 = __builtin_cpu_supports("sse4.2") != 0;
+	features.avx2 = __builtin_cpu_supports("avx2") != 0;
+	features.avx512 = (__builtin_cpu_supports("avx512f") != 0) && (__builtin_cpu_supports("avx512bw") != 0) && (__builtin_cpu_supports("avx512vl") != 0);
+#endif // _MSC_VER
+	return features;
+}
+
+inline const CpuFeatures& cpuFeatures()
+{
+	static const CpuFeatures features{ detectCpuFeatures() };
+	return features;
+}
+
+inline unsigned int countTrailingZeros(const unsigned int value) // value must not be zero
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+	unsigned long index;
+	_BitScanForward(&index, value);
+	return static_cast<unsigned int>(index);
+#else
+	return static_cast<unsigned int>(__builtin_ctz(value));
+#endif // _MSC_VER
+}
+
+
+
+// SHUFFLE TABLES
+
+struct ShuffleTable
+{
+	unsigned char masks[256][16];
+	unsigned char lengths[256];
+};
+
+// moves the 16-bit lanes whose bits are set in the index to the front
+inline ShuffleTable buildLaneCompactionTable()
+{
+	ShuffleTable table;
+	for (unsigned int index{ 0u }; index < 256u; ++index)
+	{
+		unsigned int length{ 0u };
+		for (unsigned int lane{ 0u }; lane < 8u; ++lane)
+		{
+			if (!(index & (1u << lane)))
+				continue;
+			table.masks[index][length++] = static_cast<unsigned char>(lane * 2u);
+			table.masks[index][length++] = static_cast<unsigned char>(lane * 2u + 1u);
+		}
+		table.lengths[index] = static_cast<unsigned char>(length / 2u);
+		while (length < 16u)
+			table.masks[index][length++] = 0x80;
+	}
+	return table;
+}
+
+// keeps the low byte of every 16-bit lane and also the high byte of the lanes whose bits are set in the index
+inline ShuffleTable buildByteExpansionTable()
+{
+	ShuffleTable table;
+	for (unsigned int index{ 0u }; index < 256u; ++index)
+	{
+		unsigned int length{ 0u };
+		for (unsigned int lane{ 0u }; lane < 8u; ++lane)
+		{
+			table.masks[index][length++] = static_cast<unsigned char>(lane * 2u);
+			if (index & (1u << lane))
+				table.masks[index][length++] = static_cast<unsigned char>(lane * 2u + 1u);
+		}
+		table.lengths[index] = static_cast<unsigned char>(length);
+		while (length < 16u)
+			table.masks[index][length++] = 0x80;
+	}
+	return table;
+}
+
+inline const ShuffleTable& laneCompactionTable()
+{
+	static const ShuffleTable table{ buildLaneCompactionTable() };
+	return table;
+}
+
+inline const ShuffleTable& byteExpansionTable()
+{
+	static const ShuffleTable table{ buildByteExpansionTable() };
+	return table;
+}
+
+// UTF-8 ERROR TABLES
+// for the lookup validation (by Keiser and Lemire). each pair of bytes is looked up by the high and low nibbles of the first byte and the high nibble
+// of the second; each table gives the errors that the pair could be part of and any error that is in all three is real.
+// the error bits are: 0x01 too short, 0x02 too long, 0x04 overlong (3 bytes), 0x08 too large, 0x10 surrogate, 0x20 overlong (2 bytes),
+// 0x40 too large or overlong (4 bytes) and 0x80 two continuation bytes (which is only an error if the second is not the third or fourth byte of a sequence)
+
+inline const unsigned char* utf8ErrorTable(const unsigned int index)
+{
+	static const unsigned char tables[3][16]
+	{
+		{ 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x80, 0x80, 0x80, 0x80, 0x21, 0x01, 0x15, 0x49 }, // high nibble of the first byte
+		{ 0xE7, 0xA3, 0x83, 0x83, 0x8B, 0xCB, 0xCB, 0xCB, 0xCB, 0xCB, 0xCB, 0xCB, 0xCB, 0xDB, 0xCB, 0xCB }, // low nibble of the first byte
+		{ 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0xE6, 0xAE, 0xBA, 0xBA, 0x01, 0x01, 0x01, 0x01 } // high nibble of the second byte
+	};
+	return tables[index];
+}
+
+// the start of the last code point before "in" where everything before "in" has been checked (so any error there can only be a sequence that
+// is cut short by "in"). scalar validation that continues from here finds the same errors as it would from the beginning
+inline const char* lastCodePointStart(const char* const begin, const char* in)
+{
+	for (unsigned int i{ 0u }; (i < 4u) && (in != begin); ++i)
+	{
+		if (isCodePointStart(*--in))
+			break;
+	}
+	return in;
+}
+
+
+
+// SSE4.2
+// the multi-byte paths are 128-bit only and are shared by the wider kernels.
+// every path only takes blocks that are entirely valid and otherwise leaves them to the scalar code, which keeps the results identical to the scalar kernel.
+// input is read in whole blocks (so the loops stop when a block would pass the end). a whole block of output may be written even if the result is shorter
+// but this never goes past the largest possible result of the remaining input (so is always within the room the kernels require).
+
+namespace sse42
+{
+
+// UTF-8 BLOCKS
+
+// 16 bytes (15 if the last is a lead byte) that are only ASCII and complete 2-byte sequences become code points
+// (in 16-bit lanes, packed to the front of each of the two halves). returns the number of bytes used (0 if the block does not fit)
+YUTIYEFF_TARGET_SSE42 inline unsigned int decodeOneOrTwoByteBlock(const __m128i bytes, __m128i& lowCodePoints, unsigned int& lowCount, __m128i& highCodePoints, unsigned int& highCount)
+{
+	if (!_mm_testz_si128(_mm_subs_epu8(bytes, _mm_set1_epi8(static_cast<char>(0xDF))), _mm_set1_epi8(-1))) // 3-byte and 4-byte leads (and invalid bytes)
+		return 0u;
+	const __m128i leadBytes{ _mm_cmpeq_epi8(_mm_and_si128(bytes, _mm_set1_epi8(static_cast<char>(0xE0))), _mm_set1_epi8(static_cast<char>(0xC0))) };
+	const __m128i invalidBytes{ _mm_cmpeq_epi8(_mm_and_si128(bytes, _mm_set1_epi8(static_cast<char>(0xFE))), _mm_set1_epi8(static_cast<char>(0xC0))) }; // overlong 2-byte leads
+	const unsigned int leads{ static_cast<unsigned int>(_mm_movemask_epi8(leadBytes)) };
+	const unsigned int continuations{ static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(bytes, _mm_set1_epi8(static_cast<char>(0xC0))), _mm_set1_epi8(static_cast<char>(0x80))))) };
+	if ((_mm_movemask_epi8(invalidBytes) != 0) || (((leads << 1u) & 0xFFFFu) != continuations)) // every continuation byte must follow a lead byte (and only those)
+		return 0u;
+
+	// per position: the top bits (from a lead byte) and the bottom bits (from the following continuation byte or from an ASCII byte)
+	const __m128i topBits{ _mm_and_si128(_mm_and_si128(bytes, _mm_set1_epi8(0x1F)), leadBytes) };
+	const __m128i bottomBits{ _mm_blendv_epi8(bytes, _mm_and_si128(_mm_srli_si128(bytes, 1), _mm_set1_epi8(0x3F)), leadBytes) };
+	const ShuffleTable& table{ laneCompactionTable() };
+
+	const __m128i lowLanes{ _mm_or_si128(_mm_slli_epi16(_mm_cvtepu8_epi16(topBits), 6), _mm_cvtepu8_epi16(bottomBits)) };
+	const unsigned int lowKeep{ ~continuations & 0xFFu };
+	lowCodePoints = _mm_shuffle_epi8(lowLanes, _mm_loadu_si128(reinterpret_cast<const __m128i*>(table.masks[lowKeep])));
+	lowCount = table.lengths[lowKeep];
+
+	const unsigned int used{ 16u - (leads >> 15u) };
+	const __m128i highLanes{ _mm_or_si128(_mm_slli_epi16(_mm_cvtepu8_epi16(_mm_srli_si128(topBits, 8)), 6), _mm_cvtepu8_epi16(_mm_srli_si128(bottomBits, 8))) };
+	const unsigned int highKeep{ (~continuations >> 8u) & (0xFFu >> (16u - used)) };
+	highCodePoints = _mm_shuffle_epi8(highLanes, _mm_loadu_si128(reinterpret_cast<const __m128i*>(table.masks[highKeep])));
+	highCount = table.lengths[highKeep];
+	return used;
+}
+
+// four 3-byte UTF-8 sequences in the first 12 bytes become four code points (in 32-bit lanes)
+YUTIYEFF_TARGET_SSE42 inline bool decodeThreeByteBlock(const __m128i bytes, __m128i& codePoints)
+{
+	const __m128i lanes{ _mm_shuffle_epi8(bytes, _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1)) };
+	const __m128i matchesPattern{ _mm_cmpeq_epi32(_mm_and_si128(lanes, _mm_set1_epi32(0x00F0C0C0)), _mm_set1_epi32(0x00E08080)) };
+	codePoints = _mm_or_si128(_mm_or_si128(
+		_mm_srli_epi32(_mm_and_si128(lanes, _mm_set1_epi32(0x000F0000)), 4),
+		_mm_srli_epi32(_mm_and_si128(lanes, _mm_set1_epi32(0x00003F00)), 2)),
+		_mm_and_si128(lanes, _mm_set1_epi32(0x0000003F)));
+	const __m128i topBits{ _mm_and_si128(codePoints, _mm_set1_epi32(0xF800)) };
+	const __m128i overlongOrSurrogate{ _mm_or_si128(_mm_cmpeq_epi32(topBits, _mm_setzero_si128()), _mm_cmpeq_epi32(topBits, _mm_set1_epi32(0xD800))) };
+	return _mm_movemask_epi8(_mm_andnot_si128(overlongOrSurrogate, matchesPattern)) == 0xFFFF;
+}
+
+// four 4-byte UTF-8 sequences in 16 bytes become four code points (in 32-bit lanes)
+YUTIYEFF_TARGET_SSE42 inline bool decodeFourByteBlock(const __m128i bytes, __m128i& codePoints)
+{
+	const __m128i lanes{ _mm_shuffle_epi8(bytes, _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12)) };
+	const __m128i matchesPattern{ _mm_cmpeq_epi32(_mm_and_si128(lanes, _mm_set1_epi32(static_cast<int>(0xF8C0C0C0))), _mm_set1_epi32(static_cast<int>(0xF0808080))) };
+	codePoints = _mm_or_si128(
+		_mm_or_si128(_mm_srli_epi32(_mm_and_si128(lanes, _mm_set1_epi32(0x07000000)), 6), _mm_srli_epi32(_mm_and_si128(lanes, _mm_set1_epi32(0x003F0000)), 4)),
+		_mm_or_si128(_mm_srli_epi32(_mm_and_si128(lanes, _mm_set1_epi32(0x00003F00)), 2), _mm_and_si128(lanes, _mm_set1_epi32(0x0000003F))));
+	const __m128i outOfRange{ _mm_xor_si128(_mm_cmpeq_epi32(_mm_and_si128(_mm_sub_epi32(codePoints, _mm_set1_epi32(0x10000)), _mm_set1_epi32(static_cast<int>(0xFFF00000))), _mm_setzero_si128()), _mm_set1_epi32(-1)) };
+	return _mm_movemask_epi8(_mm_andnot_si128(outOfRange, matchesPattern)) == 0xFFFF;
+}
+
+// code points (in 16-bit lanes) that are all below 0x800 become 8-16 bytes of UTF-8. returns the number of bytes
+YUTIYEFF_TARGET_SSE42 inline unsigned int encodeOneOrTwoByteBlock(const __m128i codePoints, char* const out)
+{
+	const __m128i twoByteLanes{ _mm_xor_si128(_mm_cmpeq_epi16(_mm_and_si128(codePoints, _mm_set1_epi16(static_cast<short>(0xFF80))), _mm_setzero_si128()), _mm_set1_epi16(-1)) };
+	const __m128i leads{ _mm_or_si128(_mm_srli_epi16(codePoints, 6), _mm_set1_epi16(0x00C0)) };
+	const __m128i continuations{ _mm_slli_epi16(_mm_or_si128(_mm_and_si128(codePoints, _mm_set1_epi16(0x003F)), _mm_set1_epi16(0x0080)), 8) };
+	const __m128i lanes{ _mm_blendv_epi8(codePoints, _mm_or_si128(leads, continuations), twoByteLanes) };
+	const unsigned int index{ static_cast<unsigned int>(_mm_movemask_epi8(_mm_packs_epi16(twoByteLanes, _mm_setzero_si128()))) };
+	const ShuffleTable& table{ byteExpansionTable() };
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_shuffle_epi8(lanes, _mm_loadu_si128(reinterpret_cast<const __m128i*>(table.masks[index]))));
+	return table.lengths[index];
+}
+
+// code points (in 32-bit lanes) that are all in the range 0x800-0xFFFF and are not surrogates
+YUTIYEFF_TARGET_SSE42 inline bool isThreeByteBlock(const __m128i codePoints)
+{
+	const __m128i topBits{ _mm_and_si128(codePoints, _mm_set1_epi32(0xF800)) };
+	const __m128i invalid{ _mm_or_si128(
+		_mm_or_si128(_mm_cmpeq_epi32(topBits, _mm_setzero_si128()), _mm_cmpeq_epi32(topBits, _mm_set1_epi32(0xD800))),
+		_mm_xor_si128(_mm_cmpeq_epi32(_mm_and_si128(codePoints, _mm_set1_epi32(static_cast<int>(0xFFFF0000))), _mm_setzero_si128()), _mm_set1_epi32(-1))) };
+	return _mm_movemask_epi8(invalid) == 0;
+}
+
+// writes 12 bytes: four 3-byte UTF-8 sequences from four code points (in 32-bit lanes) that pass isThreeByteBlock
+YUTIYEFF_TARGET_SSE42 inline void encodeThreeByteBlock(const __m128i codePoints, char* const out)
+{
+	const __m128i lanes{ _mm_or_si128(_mm_or_si128(
+		_mm_or_si128(_mm_srli_epi32(codePoints, 12), _mm_set1_epi32(0x000000E0)),
+		_mm_or_si128(_mm_and_si128(_mm_slli_epi32(codePoints, 2), _mm_set1_epi32(0x00003F00)), _mm_set1_epi32(0x00008000))),
+		_mm_or_si128(_mm_and_si128(_mm_slli_epi32(codePoints, 16), _mm_set1_epi32(0x003F0000)), _mm_set1_epi32(0x00800000))) };
+	const __m128i packed{ _mm_shuffle_epi8(lanes, _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1)) };
+	_mm_storel_epi64(reinterpret_cast<__m128i*>(out), packed);
+	const int last{ _mm_cvtsi128_si32(_mm_srli_si128(packed, 8)) };
+	std::memcpy(out + 8, &last, 4u);
+}
+
+// code points (in 32-bit lanes) that are all in the range 0x10000-0x10FFFF
+YUTIYEFF_TARGET_SSE42 inline bool isFourByteBlock(const __m128i codePoints)
+{
+	return _mm_testz_si128(_mm_sub_epi32(codePoints, _mm_set1_epi32(0x10000)), _mm_set1_epi32(static_cast<int>(0xFFF00000))) != 0;
+}
+
+// writes 16 bytes: four 4-byte UTF-8 sequences from four code points (in 32-bit lanes) that pass isFourByteBlock
+YUTIYEFF_TARGET_SSE42 inline void encodeFourByteBlock(const __m128i codePoints, char* const out)
+{
+	const __m128i lanes{ _mm_or_si128(
+		_mm_or_si128(
+			_mm_or_si128(_mm_srli_epi32(codePoints, 18), _mm_set1_epi32(0x000000F0)),
+			_mm_or_si128(_mm_and_si128(_mm_srli_epi32(codePoints, 4), _mm_set1_epi32(0x00003F00)), _mm_set1_epi32(0x00008000))),
+		_mm_or_si128(
+			_mm_or_si128(_mm_and_si128(_mm_slli_epi32(codePoints, 10), _mm_set1_epi32(0x003F0000)), _mm_set1_epi32(0x00800000)),
+			_mm_or_si128(_mm_and_si128(_mm_slli_epi32(codePoints, 24), _mm_set1_epi32(0x3F000000)), _mm_set1_epi32(static_cast<int>(0x80000000))))) };
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(out), lanes);
+}
+
+
+
+// UTF-16 BLOCKS
+
+// code units (in 16-bit lanes) that are surrogates. returns a 16-bit mask with 2 bits per code unit
+YUTIYEFF_TARGET_SSE42 inline unsigned int surrogateMask(const __m128i units)
+{
+	return static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(units, _mm_set1_epi16(static_cast<short>(0xF800))), _mm_set1_epi16(static_cast<short>(0xD800)))));
+}
+
+// four surrogate pairs in 8 code units become four code points (in 32-bit lanes)
+YUTIYEFF_TARGET_SSE42 inline bool decodeSurrogatePairBlock(const __m128i units, __m128i& codePoints)
+{
+	const __m128i matchesPattern{ _mm_cmpeq_epi32(_mm_and_si128(units, _mm_set1_epi32(static_cast<int>(0xFC00FC00))), _mm_set1_epi32(static_cast<int>(0xDC00D800))) };
+	if (_mm_movemask_epi8(matchesPattern) != 0xFFFF)
+		return false;
+	codePoints = _mm_add_epi32(_mm_or_si128(_mm_slli_epi32(_mm_and_si128(units, _mm_set1_epi32(0x3FF)), 10), _mm_and_si128(_mm_srli_epi32(units, 16), _mm_set1_epi32(0x3FF))), _mm_set1_epi32(0x10000));
+	return true;
+}
+
+// writes 8 code units: four surrogate pairs from four code points (in 32-bit lanes) that pass isFourByteBlock
+YUTIYEFF_TARGET_SSE42 inline void encodeSurrogatePairBlock(const __m128i codePoints, char16_t* const out)
+{
+	const __m128i offset{ _mm_sub_epi32(codePoints, _mm_set1_epi32(0x10000)) };
+	const __m128i highSurrogates{ _mm_or_si128(_mm_srli_epi32(offset, 10), _mm_set1_epi32(0xD800)) };
+	const __m128i lowSurrogates{ _mm_slli_epi32(_mm_or_si128(_mm_and_si128(offset, _mm_set1_epi32(0x3FF)), _mm_set1_epi32(0xDC00)), 16) };
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_or_si128(highSurrogates, lowSurrogates));
+}
+
+
+
+// STEPS
+// each step needs at least 16 code units of input and always makes progress.
+// when none of the blocks fit, the next 64 code units (32 for UTF-16) are left to the scalar code so that mixed text doesn't keep retrying (and failing) the blocks.
+
+YUTIYEFF_TARGET_SSE42 inline void utf32FromUtf8Step(const char*& in, const char* const end, char32_t*& out)
+{
+	const __m128i bytes{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(in)) };
+	const unsigned int nonAscii{ static_cast<unsigned int>(_mm_movemask_epi8(bytes)) };
+	if (nonAscii == 0u)
+	{
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_cvtepu8_epi32(bytes));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4), _mm_cvtepu8_epi32(_mm_srli_si128(bytes, 4)));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8), _mm_cvtepu8_epi32(_mm_srli_si128(bytes, 8)));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 12), _mm_cvtepu8_epi32(_mm_srli_si128(bytes, 12)));
+		in += 16;
+		out += 16;
+		return;
+	}
+	const unsigned char lead{ static_cast<unsigned char>(*in) };
+	__m128i codePoints;
+	if (((lead & 0xF0) == 0xE0) && decodeThreeByteBlock(bytes, codePoints))
+	{
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out), codePoints);
+		in += 12;
+		out += 4;
+		return;
+	}
+	if (((lead & 0xF8) == 0xF0) && decodeFourByteBlock(bytes, codePoints))
+	{
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out), codePoints);
+		in += 16;
+		out += 4;
+		return;
+	}
+	__m128i highCodePoints;
+	unsigned int lowCount, highCount;
+	const unsigned int used{ decodeOneOrTwoByteBlock(bytes, codePoints, lowCount, highCodePoints, highCount) };
+	if (used != 0u)
+	{
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_cvtepu16_epi32(codePoints));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4), _mm_cvtepu16_epi32(_mm_srli_si128(codePoints, 8)));
+		out += lowCount;
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_cvtepu16_epi32(highCodePoints));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4), _mm_cvtepu16_epi32(_mm_srli_si128(highCodePoints, 8)));
+		out += highCount;
+		in += used;
+		return;
+	}
+	out = scalar::utf32FromUtf8Until(in, ((end - in) > 64) ? (in + 64) : end, end, out);
+}
+
+YUTIYEFF_TARGET_SSE42 inline void utf16FromUtf8Step(const char*& in, const char* const end, char16_t*& out)
+{
+	const __m128i bytes{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(in)) };
+	const unsigned int nonAscii{ static_cast<unsigned int>(_mm_movemask_epi8(bytes)) };
+	if (nonAscii == 0u)
+	{
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_cvtepu8_epi16(bytes));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8), _mm_cvtepu8_epi16(_mm_srli_si128(bytes, 8)));
+		in += 16;
+		out += 16;
+		return;
+	}
+	const unsigned char lead{ static_cast<unsigned char>(*in) };
+	__m128i codePoints;
+	if (((lead & 0xF0) == 0xE0) && decodeThreeByteBlock(bytes, codePoints))
+	{
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(out), _mm_packus_epi32(codePoints, codePoints));
+		in += 12;
+		out += 4;
+		return;
+	}
+	if (((lead & 0xF8) == 0xF0) && decodeFourByteBlock(bytes, codePoints))
+	{
+		encodeSurrogatePairBlock(codePoints, out);
+		in += 16;
+		out += 8;
+		return;
+	}
+	__m128i highCodePoints;
+	unsigned int lowCount, highCount;
+	const unsigned int used{ decodeOneOrTwoByteBlock(bytes, codePoints, lowCount, highCodePoints, highCount) };
+	if (used != 0u)
+	{
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out), codePoints);
+		out += lowCount;
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out), highCodePoints);
+		out += highCount;
+		in += used;
+		return;
+	}
+	out = scalar::utf16FromUtf8Until(in, ((end - in) > 64) ? (in + 64) : end, end, out);
+}
+
+YUTIYEFF_TARGET_SSE42 inline void utf32FromUtf16Step(const char16_t*& in, const char16_t* const end, char32_t*& out)
+{
+	const __m128i units{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(in)) };
+	const unsigned int surrogates{ surrogateMask(units) };
+	if (surrogates == 0u)
+	{
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_cvtepu16_epi32(units));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4), _mm_cvtepu16_epi32(_mm_srli_si128(units, 8)));
+		in += 8;
+		out += 8;
+		return;
+	}
+	__m128i codePoints;
+	if (decodeSurrogatePairBlock(units, codePoints))
+	{
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out), codePoints);
+		in += 8;
+		out += 4;
+		return;
+	}
+	const unsigned int directLength{ countTrailingZeros(surrogates) / 2u };
+	if (directLength != 0u)
+	{
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_cvtepu16_epi32(units));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4), _mm_cvtepu16_epi32(_mm_srli_si128(units, 8)));
+		in += directLength;
+		out += directLength;
+		return;
+	}
+	out = scalar::utf32FromUtf16Until(in, ((end - in) > 32) ? (in + 32) : end, end, out);
+}
+
+YUTIYEFF_TARGET_SSE42 inline void utf8FromUtf16Step(const char16_t*& in, const char16_t* const end, char*& out)
+{
+	const __m128i units{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(in)) };
+	const __m128i nextUnits{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 8)) };
+	if (_mm_testz_si128(_mm_or_si128(units, nextUnits), _mm_set1_epi16(static_cast<short>(0xFF80))))
+	{
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(units, nextUnits));
+		in += 16;
+		out += 16;
+		return;
+	}
+	if (_mm_testz_si128(units, _mm_set1_epi16(static_cast<short>(0xF800))))
+	{
+		out += encodeOneOrTwoByteBlock(units, out);
+		in += 8;
+		return;
+	}
+	const __m128i lowCodePoints{ _mm_cvtepu16_epi32(units) };
+	const __m128i highCodePoints{ _mm_cvtepu16_epi32(_mm_srli_si128(units, 8)) };
+	if (isThreeByteBlock(lowCodePoints) && isThreeByteBlock(highCodePoints))
+	{
+		encodeThreeByteBlock(lowCodePoints, out);
+		encodeThreeByteBlock(highCodePoints, out + 12);
+		in += 8;
+		out += 24;
+		return;
+	}
+	__m128i codePoints;
+	if (decodeSurrogatePairBlock(units, codePoints))
+	{
+		encodeFourByteBlock(codePoints, out);
+		in += 8;
+		out += 16;
+		return;
+	}
+	out = scalar::utf8FromUtf16Until(in, ((end - in) > 32) ? (in + 32) : end, end, out);
+}
+
+YUTIYEFF_TARGET_SSE42 inline void utf8FromUtf32Step(const char32_t*& in, const char32_t* const end, char*& out)
+{
+	const __m128i codePoints0{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(in)) };
+	const __m128i codePoints1{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 4)) };
+	const __m128i codePoints2{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 8)) };
+	const __m128i codePoints3{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 12)) };
+	const __m128i all{ _mm_or_si128(_mm_or_si128(codePoints0, codePoints1), _mm_or_si128(codePoints2, codePoints3)) };
+	if (_mm_testz_si128(all, _mm_set1_epi32(static_cast<int>(0xFFFFFF80))))
+	{
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(_mm_packus_epi32(codePoints0, codePoints1), _mm_packus_epi32(codePoints2, codePoints3)));
+		in += 16;
+		out += 16;
+		return;
+	}
+	if (_mm_testz_si128(_mm_or_si128(codePoints0, codePoints1), _mm_set1_epi32(static_cast<int>(0xFFFFF800))))
+	{
+		out += encodeOneOrTwoByteBlock(_mm_packus_epi32(codePoints0, codePoints1), out);
+		in += 8;
+		return;
+	}
+	if (isThreeByteBlock(codePoints0))
+	{
+		encodeThreeByteBlock(codePoints0, out);
+		in += 4;
+		out += 12;
+		return;
+	}
+	if (isFourByteBlock(codePoints0))
+	{
+		encodeFourByteBlock(codePoints0, out);
+		in += 4;
+		out += 16;
+		return;
+	}
+	const char32_t* const windowEnd{ ((end - in) > 64) ? (in + 64) : end };
+	out = scalar::utf8FromUtf32(in, windowEnd, out);
+	in = windowEnd;
+}
+
+YUTIYEFF_TARGET_SSE42 inline void utf16FromUtf32Step(const char32_t*& in, const char32_t* const end, char16_t*& out)
+{
+	const __m128i codePoints0{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(in)) };
+	const __m128i codePoints1{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 4)) };
+	const __m128i units{ _mm_packus_epi32(codePoints0, codePoints1) };
+	if (_mm_testz_si128(_mm_or_si128(codePoints0, codePoints1), _mm_set1_epi32(static_cast<int>(0xFFFF0000))) && (surrogateMask(units) == 0u))
+	{
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out), units);
+		in += 8;
+		out += 8;
+		return;
+	}
+	if (isFourByteBlock(codePoints0))
+	{
+		encodeSurrogatePairBlock(codePoints0, out);
+		in += 4;
+		out += 8;
+		return;
+	}
+	const char32_t* const windowEnd{ ((end - in) > 64) ? (in + 64) : end };
+	out = scalar::utf16FromUtf32(in, windowEnd, out);
+	in = windowEnd;
+}
+
+
+
+// KERNELS
+
+YUTIYEFF_TARGET_SSE42 inline char* utf8FromUtf32(const char32_t* in, const char32_t* const end, char* out)
+{
+	while ((end - in) >= 16)
+		utf8FromUtf32Step(in, end, out);
+	return scalar::utf8FromUtf32(in, end, out);
+}
+
+YUTIYEFF_TARGET_SSE42 inline char16_t* utf16FromUtf32(const char32_t* in, const char32_t* const end, char16_t* out)
+{
+	while ((end - in) >= 16)
+		utf16FromUtf32Step(in, end, out);
+	return scalar::utf16FromUtf32(in, end, out);
+}
+
+YUTIYEFF_TARGET_SSE42 inline char32_t* utf32FromUtf8(const char* in, const char* const end, char32_t* out)
+{
+	while ((end - in) >= 16)
+		utf32FromUtf8Step(in, end, out);
+	return scalar::utf32FromUtf8(in, end, out);
+}
+
+YUTIYEFF_TARGET_SSE42 inline char32_t* utf32FromUtf16(const char16_t* in, const char16_t* const end, char32_t* out)
+{
+	while ((end - in) >= 16)
+		utf32FromUtf16Step(in, end, out);
+	return scalar::utf32FromUtf16(in, end, out);
+}
+
+YUTIYEFF_TARGET_SSE42 inline char* utf8FromUtf16(const char16_t* in, const char16_t* const end, char* out)
+{
+	while ((end - in) >= 16)
+		utf8FromUtf16Step(in, end, out);
+	return scalar::utf8FromUtf16(in, end, out);
+}
+
+YUTIYEFF_TARGET_SSE42 inline char16_t* utf16FromUtf8(const char* in, const char* const end, char16_t* out)
+{
+	while ((end - in) >= 16)
+		utf16FromUtf8Step(in, end, out);
+	return scalar::utf16FromUtf8(in, end, out);
+}
+
+// COUNTING
+// matching code units are counted in 8-bit (or 16-bit) lanes which are summed after at most 255 blocks (before the lanes could overflow)
+
+YUTIYEFF_TARGET_SSE42 inline std::size_t codePointCountUtf8(const char* in, const char* const end)
+{
+	std::size_t count{ 0u };
+	while ((end - in) >= 16)
+	{
+		const std::size_t blockCount{ std::min(static_cast<std::size_t>(end - in) / 16u, std::size_t{ 255u }) };
+		__m128i continuations{ _mm_setzero_si128() };
+		for (std::size_t i{ 0u }; i < blockCount; ++i, in += 16)
+			continuations = _mm_sub_epi8(continuations, _mm_cmplt_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in)), _mm_set1_epi8(-64))); // 0x80-0xBF are the only bytes below 0xC0 (as signed)
+		const __m128i sums{ _mm_sad_epu8(continuations, _mm_setzero_si128()) };
+		count += (blockCount * 16u) - static_cast<std::size_t>(_mm_cvtsi128_si32(sums) + _mm_cvtsi128_si32(_mm_unpackhi_epi64(sums, sums)));
+	}
+	return count + scalar::codePointCountUtf8(in, end);
+}
+
+YUTIYEFF_TARGET_SSE42 inline std::size_t codePointCountUtf16(const char16_t* in, const char16_t* const end)
+{
+	std::size_t count{ 0u };
+	while ((end - in) >= 8)
+	{
+		const std::size_t blockCount{ std::min(static_cast<std::size_t>(end - in) / 8u, std::size_t{ 255u }) };
+		__m128i lowSurrogates{ _mm_setzero_si128() };
+		for (std::size_t i{ 0u }; i < blockCount; ++i, in += 8)
+		{
+			const __m128i units{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(in)) };
+			lowSurrogates = _mm_sub_epi16(lowSurrogates, _mm_cmpeq_epi16(_mm_and_si128(units, _mm_set1_epi16(static_cast<short>(0xFC00))), _mm_set1_epi16(static_cast<short>(0xDC00))));
+		}
+		__m128i sums{ _mm_madd_epi16(lowSurrogates, _mm_set1_epi16(1)) };
+		sums = _mm_add_epi32(sums, _mm_unpackhi_epi64(sums, sums));
+		sums = _mm_add_epi32(sums, _mm_srli_epi64(sums, 32));
+		count += (blockCount * 8u) - static_cast<std::size_t>(_mm_cvtsi128_si32(sums));
+	}
+	return count + scalar::codePointCountUtf16(in, end);
+}
+
+// SEARCHING
+// candidates are positions where both the first and the last code unit of the needle match (a whole block at a time); only those are compared fully
+
+YUTIYEFF_TARGET_SSE42 inline const char* findUtf8(const char* in, const char* const end, const char* const needle, const std::size_t needleLength)
+{
+	const __m128i first{ _mm_set1_epi8(needle[0]) };
+	const __m128i last{ _mm_set1_epi8(needle[needleLength - 1u]) };
+	while (static_cast<std::size_t>(end - in) >= (needleLength + 15u))
+	{
+		const __m128i firstMatches{ _mm_cmpeq_epi8(first, _mm_loadu_si128(reinterpret_cast<const __m128i*>(in))) };
+		const __m128i lastMatches{ _mm_cmpeq_epi8(last, _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + needleLength - 1u))) };
+		for (unsigned int candidates{ static_cast<unsigned int>(_mm_movemask_epi8(_mm_and_si128(firstMatches, lastMatches))) }; candidates != 0u; candidates &= candidates - 1u)
+		{
+			const char* const candidate{ in + countTrailingZeros(candidates) };
+			if (std::memcmp(candidate, needle, needleLength) == 0)
+				return candidate;
+		}
+		in += 16;
+	}
+	return scalar::findUtf8(in, end, needle, needleLength);
+}
+
+YUTIYEFF_TARGET_SSE42 inline const char16_t* findUtf16(const char16_t* in, const char16_t* const end, const char16_t* const needle, const std::size_t needleLength)
+{
+	const __m128i first{ _mm_set1_epi16(static_cast<short>(needle[0])) };
+	const __m128i last{ _mm_set1_epi16(static_cast<short>(needle[needleLength - 1u])) };
+	while (static_cast<std::size_t>(end - in) >= (needleLength + 7u))
+	{
+		const __m128i firstMatches{ _mm_cmpeq_epi16(first, _mm_loadu_si128(reinterpret_cast<const __m128i*>(in))) };
+		const __m128i lastMatches{ _mm_cmpeq_epi16(last, _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + needleLength - 1u))) };
+		for (unsigned int candidates{ static_cast<unsigned int>(_mm_movemask_epi8(_mm_and_si128(firstMatches, lastMatches))) & 0x5555u }; candidates != 0u; candidates &= candidates - 1u)
+		{
+			const char16_t* const candidate{ in + (countTrailingZeros(candidates) / 2u) };
+			if (std::memcmp(candidate, needle, needleLength * sizeof(char16_t)) == 0)
+				return candidate;
+		}
+		in += 8;
+	}
+	return scalar::findUtf16(in, end, needle, needleLength);
+}
+
+
+// VALIDATING
+// blocks only report whether they have an error; the scalar code then finds exactly where it is (starting from the last code point before the block).
+// blocks that are all ASCII (and follow a block that is all ASCII) can't have an error so are skipped.
+
+// the error bits (see utf8ErrorTable) of each byte in a block (that follows "previousBytes"). all zero if there are none
+YUTIYEFF_TARGET_SSE42 inline __m128i utf8BlockErrors(const __m128i bytes, const __m128i previousBytes)
+{
+	const __m128i lowNibbles{ _mm_set1_epi8(0x0F) };
+	const __m128i previous1{ _mm_alignr_epi8(bytes, previousBytes, 15) };
+	const __m128i byte1High{ _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(utf8ErrorTable(0u))), _mm_and_si128(_mm_srli_epi16(previous1, 4), lowNibbles)) };
+	const __m128i byte1Low{ _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(utf8ErrorTable(1u))), _mm_and_si128(previous1, lowNibbles)) };
+	const __m128i byte2High{ _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(utf8ErrorTable(2u))), _mm_and_si128(_mm_srli_epi16(bytes, 4), lowNibbles)) };
+	const __m128i pairErrors{ _mm_and_si128(_mm_and_si128(byte1High, byte1Low), byte2High) };
+
+	// bytes two or three after a lead of a 3-byte or 4-byte sequence (the saturating subtraction leaves the top bit set only for those leads)
+	const __m128i isThird{ _mm_subs_epu8(_mm_alignr_epi8(bytes, previousBytes, 14), _mm_set1_epi8(0x60)) };
+	const __m128i isFourth{ _mm_subs_epu8(_mm_alignr_epi8(bytes, previousBytes, 13), _mm_set1_epi8(0x70)) };
+	const __m128i mustBeContinuation{ _mm_and_si128(_mm_or_si128(isThird, isFourth), _mm_set1_epi8(static_cast<char>(0x80))) };
+	return _mm_xor_si128(mustBeContinuation, pairErrors);
+}
+
+YUTIYEFF_TARGET_SSE42 inline const char* findInvalidUtf8(const char* const begin, const char* const end)
+{
+	const char* in{ begin };
+	__m128i previousBytes{ _mm_setzero_si128() };
+	bool isPreviousAscii{ true };
+	for (; (end - in) >= 16; in += 16)
+	{
+		const __m128i bytes{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(in)) };
+		const bool isAscii{ _mm_movemask_epi8(bytes) == 0 };
+		if (!isAscii || !isPreviousAscii)
+		{
+			const __m128i errors{ utf8BlockErrors(bytes, previousBytes) };
+			if (!_mm_testz_si128(errors, errors))
+				break;
+		}
+		previousBytes = bytes;
+		isPreviousAscii = isAscii;
+	}
+	return scalar::findInvalidUtf8(lastCodePointStart(begin, in), end);
+}
+
+YUTIYEFF_TARGET_SSE42 inline const char16_t* findInvalidUtf16(const char16_t* const begin, const char16_t* const end)
+{
+	// each low surrogate must follow a high surrogate and each high surrogate must be followed by a low surrogate so (with 2 bits per code unit)
+	// the low surrogates are the high surrogates moved along by one code unit (the last high surrogate of a block is carried into the next)
+	const char16_t* in{ begin };
+	unsigned int carry{ 0u };
+	for (; (end - in) >= 8; in += 8)
+	{
+		const __m128i surrogateBits{ _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in)), _mm_set1_epi16(static_cast<short>(0xFC00))) };
+		const unsigned int highMask{ static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi16(surrogateBits, _mm_set1_epi16(static_cast<short>(0xD800))))) };
+		const unsigned int lowMask{ static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi16(surrogateBits, _mm_set1_epi16(static_cast<short>(0xDC00))))) };
+		if (lowMask != (((highMask << 2u) | carry) & 0xFFFFu))
+			break;
+		carry = highMask >> 14u;
+	}
+	return scalar::findInvalidUtf16((carry != 0u) ? (in - 1) : in, end);
+}
+
+} // namespace sse42
+
+
+
+// AVX2
+// ASCII and BMP-only blocks are handled 256 bits at a time; everything else is passed to the SSE4.2 steps.
+
+namespace avx2
+{
+
+YUTIYEFF_TARGET_AVX2 inline char* utf8FromUtf32(const char32_t* in, const char32_t* const end, char* out)
+{
+	while ((end - in) >= 32)
+	{
+		const __m256i codePoints0{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in)) };
+		const __m256i codePoints1{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 8)) };
+		const __m256i codePoints2{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 16)) };
+		const __m256i codePoints3{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 24)) };
+		const __m256i all{ _mm256_or_si256(_mm256_or_si256(codePoints0, codePoints1), _mm256_or_si256(codePoints2, codePoints3)) };
+		if (!_mm256_testz_si256(all, _mm256_set1_epi32(static_cast<int>(0xFFFFFF80))))
+		{
+			sse42::utf8FromUtf32Step(in, end, out);
+			continue;
+		}
+		const __m256i bytes{ _mm256_packus_epi16(_mm256_packus_epi32(codePoints0, codePoints1), _mm256_packus_epi32(codePoints2, codePoints3)) };
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_permutevar8x32_epi32(bytes, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7)));
+		in += 32;
+		out += 32;
+	}
+	return sse42::utf8FromUtf32(in, end, out);
+}
+
+YUTIYEFF_TARGET_AVX2 inline char16_t* utf16FromUtf32(const char32_t* in, const char32_t* const end, char16_t* out)
+{
+	while ((end - in) >= 16)
+	{
+		const __m256i codePoints0{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in)) };
+		const __m256i codePoints1{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 8)) };
+		const __m256i units{ _mm256_permute4x64_epi64(_mm256_packus_epi32(codePoints0, codePoints1), 0xD8) };
+		const __m256i fitsSixteenBits{ _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_or_si256(codePoints0, codePoints1), _mm256_set1_epi32(static_cast<int>(0xFFFF0000))), _mm256_setzero_si256()) };
+		const __m256i surrogates{ _mm256_cmpeq_epi16(_mm256_and_si256(units, _mm256_set1_epi16(static_cast<short>(0xF800))), _mm256_set1_epi16(static_cast<short>(0xD800))) };
+		if ((_mm256_movemask_epi8(fitsSixteenBits) != -1) || (_mm256_movemask_epi8(surrogates) != 0))
+		{
+			sse42::utf16FromUtf32Step(in, end, out);
+			continue;
+		}
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), units);
+		in += 16;
+		out += 16;
+	}
+	return sse42::utf16FromUtf32(in, end, out);
+}
+
+YUTIYEFF_TARGET_AVX2 inline char32_t* utf32FromUtf8(const char* in, const char* const end, char32_t* out)
+{
+	while ((end - in) >= 32)
+	{
+		const __m256i bytes{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in)) };
+		if (_mm256_movemask_epi8(bytes) != 0)
+		{
+			sse42::utf32FromUtf8Step(in, end, out);
+			continue;
+		}
+		const __m128i low{ _mm256_castsi256_si128(bytes) };
+		const __m128i high{ _mm256_extracti128_si256(bytes, 1) };
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_cvtepu8_epi32(low));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 8), _mm256_cvtepu8_epi32(_mm_srli_si128(low, 8)));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 16), _mm256_cvtepu8_epi32(high));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 24), _mm256_cvtepu8_epi32(_mm_srli_si128(high, 8)));
+		in += 32;
+		out += 32;
+	}
+	return sse42::utf32FromUtf8(in, end, out);
+}
+
+YUTIYEFF_TARGET_AVX2 inline char32_t* utf32FromUtf16(const char16_t* in, const char16_t* const end, char32_t* out)
+{
+	while ((end - in) >= 16)
+	{
+		const __m256i units{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in)) };
+		const __m256i surrogates{ _mm256_cmpeq_epi16(_mm256_and_si256(units, _mm256_set1_epi16(static_cast<short>(0xF800))), _mm256_set1_epi16(static_cast<short>(0xD800))) };
+		if (_mm256_movemask_epi8(surrogates) != 0)
+		{
+			sse42::utf32FromUtf16Step(in, end, out);
+			continue;
+		}
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_cvtepu16_epi32(_mm256_castsi256_si128(units)));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 8), _mm256_cvtepu16_epi32(_mm256_extracti128_si256(units, 1)));
+		in += 16;
+		out += 16;
+	}
+	return sse42::utf32FromUtf16(in, end, out);
+}
+
+YUTIYEFF_TARGET_AVX2 inline char* utf8FromUtf16(const char16_t* in, const char16_t* const end, char* out)
+{
+	while ((end - in) >= 32)
+	{
+		const __m256i units0{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in)) };
+		const __m256i units1{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 16)) };
+		if (!_mm256_testz_si256(_mm256_or_si256(units0, units1), _mm256_set1_epi16(static_cast<short>(0xFF80))))
+		{
+			sse42::utf8FromUtf16Step(in, end, out);
+			continue;
+		}
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_permute4x64_epi64(_mm256_packus_epi16(units0, units1), 0xD8));
+		in += 32;
+		out += 32;
+	}
+	return sse42::utf8FromUtf16(in, end, out);
+}
+
+YUTIYEFF_TARGET_AVX2 inline char16_t* utf16FromUtf8(const char* in, const char* const end, char16_t* out)
+{
+	while ((end - in) >= 32)
+	{
+		const __m256i bytes{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in)) };
+		if (_mm256_movemask_epi8(bytes) != 0)
+		{
+			sse42::utf16FromUtf8Step(in, end, out);
+			continue;
+		}
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_cvtepu8_epi16(_mm256_castsi256_si128(bytes)));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 16), _mm256_cvtepu8_epi16(_mm256_extracti128_si256(bytes, 1)));
+		in += 32;
+		out += 32;
+	}
+	return sse42::utf16FromUtf8(in, end, out);
+}
+
+YUTIYEFF_TARGET_AVX2 inline std::size_t codePointCountUtf8(const char* in, const char* const end)
+{
+	std::size_t count{ 0u };
+	while ((end - in) >= 32)
+	{
+		const std::size_t blockCount{ std::min(static_cast<std::size_t>(end - in) / 32u, std::size_t{ 255u }) };
+		__m256i continuations{ _mm256_setzero_si256() };
+		for (std::size_t i{ 0u }; i < blockCount; ++i, in += 32)
+			continuations = _mm256_sub_epi8(continuations, _mm256_cmpgt_epi8(_mm256_set1_epi8(-64), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in))));
+		const __m256i sums{ _mm256_sad_epu8(continuations, _mm256_setzero_si256()) };
+		const __m128i halfSums{ _mm_add_epi64(_mm256_castsi256_si128(sums), _mm256_extracti128_si256(sums, 1)) };
+		count += (blockCount * 32u) - static_cast<std::size_t>(_mm_cvtsi128_si32(halfSums) + _mm_cvtsi128_si32(_mm_unpackhi_epi64(halfSums, halfSums)));
+	}
+	return count + sse42::codePointCountUtf8(in, end);
+}
+
+YUTIYEFF_TARGET_AVX2 inline std::size_t codePointCountUtf16(const char16_t* in, const char16_t* const end)
+{
+	std::size_t count{ 0u };
+	while ((end - in) >= 16)
+	{
+		const std::size_t blockCount{ std::min(static_cast<std::size_t>(end - in) / 16u, std::size_t{ 255u }) };
+		__m256i lowSurrogates{ _mm256_setzero_si256() };
+		for (std::size_t i{ 0u }; i < blockCount; ++i, in += 16)
+		{
+			const __m256i units{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in)) };
+			lowSurrogates = _mm256_sub_epi16(lowSurrogates, _mm256_cmpeq_epi16(_mm256_and_si256(units, _mm256_set1_epi16(static_cast<short>(0xFC00))), _mm256_set1_epi16(static_cast<short>(0xDC00))));
+		}
+		const __m256i sums{ _mm256_madd_epi16(lowSurrogates, _mm256_set1_epi16(1)) };
+		__m128i halfSums{ _mm_add_epi32(_mm256_castsi256_si128(sums), _mm256_extracti128_si256(sums, 1)) };
+		halfSums = _mm_add_epi32(halfSums, _mm_unpackhi_epi64(halfSums, halfSums));
+		halfSums = _mm_add_epi32(halfSums, _mm_srli_epi64(halfSums, 32));
+		count += (blockCount * 16u) - static_cast<std::size_t>(_mm_cvtsi128_si32(halfSums));
+	}
+	return count + sse42::codePointCountUtf16(in, end);
+}
+
+YUTIYEFF_TARGET_AVX2 inline const char* findUtf8(const char* in, const char* const end, const char* const needle, const std::size_t needleLength)
+{
+	const __m256i first{ _mm256_set1_epi8(needle[0]) };
+	const __m256i last{ _mm256_set1_epi8(needle[needleLength - 1u]) };
+	while (static_cast<std::size_t>(end - in) >= (needleLength + 31u))
+	{
+		const __m256i firstMatches{ _mm256_cmpeq_epi8(first, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in))) };
+		const __m256i lastMatches{ _mm256_cmpeq_epi8(last, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + needleLength - 1u))) };
+		for (unsigned int candidates{ static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_and_si256(firstMatches, lastMatches))) }; candidates != 0u; candidates &= candidates - 1u)
+		{
+			const char* const candidate{ in + countTrailingZeros(candidates) };
+			if (std::memcmp(candidate, needle, needleLength) == 0)
+				return candidate;
+		}
+		in += 32;
+	}
+	return sse42::findUtf8(in, end, needle, needleLength);
+}
+
+YUTIYEFF_TARGET_AVX2 inline const char16_t* findUtf16(const char16_t* in, const char16_t* const end, const char16_t* const needle, const std::size_t needleLength)
+{
+	const __m256i first{ _mm256_set1_epi16(static_cast<short>(needle[0])) };
+	const __m256i last{ _mm256_set1_epi16(static_cast<short>(needle[needleLength - 1u])) };
+	while (static_cast<std::size_t>(end - in) >= (needleLength + 15u))
+	{
+		const __m256i firstMatches{ _mm256_cmpeq_epi16(first, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in))) };
+		const __m256i lastMatches{ _mm256_cmpeq_epi16(last, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + needleLength - 1u))) };
+		for (unsigned int candidates{ static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_and_si256(firstMatches, lastMatches))) & 0x55555555u }; candidates != 0u; candidates &= candidates - 1u)
+		{
+			const char16_t* const candidate{ in + (countTrailingZeros(candidates) / 2u) };
+			if (std::memcmp(candidate, needle, needleLength * sizeof(char16_t)) == 0)
+				return candidate;
+		}
+		in += 16;
+	}
+	return sse42::findUtf16(in, end, needle, needleLength);
+}
+
+// the bytes of a block moved along by "shift" with the last of the previous block moved in (across both halves)
+template <int shift>
+YUTIYEFF_TARGET_AVX2 inline __m256i shiftedBlock(const __m256i bytes, const __m256i previousBytes)
+{
+	return _mm256_alignr_epi8(bytes, _mm256_permute2x128_si256(previousBytes, bytes, 0x21), 16 - shift);
+}
+
+YUTIYEFF_TARGET_AVX2 inline __m256i utf8BlockErrors(const __m256i bytes, const __m256i previousBytes)
+{
+	const __m256i lowNibbles{ _mm256_set1_epi8(0x0F) };
+	const __m256i previous1{ shiftedBlock<1>(bytes, previousBytes) };
+	const __m256i byte1High{ _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(utf8ErrorTable(0u)))), _mm256_and_si256(_mm256_srli_epi16(previous1, 4), lowNibbles)) };
+	const __m256i byte1Low{ _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(utf8ErrorTable(1u)))), _mm256_and_si256(previous1, lowNibbles)) };
+	const __m256i byte2High{ _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(utf8ErrorTable(2u)))), _mm256_and_si256(_mm256_srli_epi16(bytes, 4), lowNibbles)) };
+	const __m256i pairErrors{ _mm256_and_si256(_mm256_and_si256(byte1High, byte1Low), byte2High) };
+	const __m256i isThird{ _mm256_subs_epu8(shiftedBlock<2>(bytes, previousBytes), _mm256_set1_epi8(0x60)) };
+	const __m256i isFourth{ _mm256_subs_epu8(shiftedBlock<3>(bytes, previousBytes), _mm256_set1_epi8(0x70)) };
+	const __m256i mustBeContinuation{ _mm256_and_si256(_mm256_or_si256(isThird, isFourth), _mm256_set1_epi8(static_cast<char>(0x80))) };
+	return _mm256_xor_si256(mustBeContinuation, pairErrors);
+}
+
+YUTIYEFF_TARGET_AVX2 inline const char* findInvalidUtf8(const char* const begin, const char* const end)
+{
+	const char* in{ begin };
+	__m256i previousBytes{ _mm256_setzero_si256() };
+	bool isPreviousAscii{ true };
+	for (; (end - in) >= 32; in += 32)
+	{
+		const __m256i bytes{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in)) };
+		const bool isAscii{ _mm256_movemask_epi8(bytes) == 0 };
+		if (!isAscii || !isPreviousAscii)
+		{
+			const __m256i errors{ utf8BlockErrors(bytes, previousBytes) };
+			if (!_mm256_testz_si256(errors, errors))
+				break;
+		}
+		previousBytes = bytes;
+		isPreviousAscii = isAscii;
+	}
+	return scalar::findInvalidUtf8(lastCodePointStart(begin, in), end);
+}
+
+YUTIYEFF_TARGET_AVX2 inline const char16_t* findInvalidUtf16(const char16_t* const begin, const char16_t* const end)
+{
+	const char16_t* in{ begin };
+	unsigned int carry{ 0u };
+	for (; (end - in) >= 16; in += 16)
+	{
+		const __m256i surrogateBits{ _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in)), _mm256_set1_epi16(static_cast<short>(0xFC00))) };
+		const unsigned int highMask{ static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi16(surrogateBits, _mm256_set1_epi16(static_cast<short>(0xD800))))) };
+		const unsigned int lowMask{ static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi16(surrogateBits, _mm256_set1_epi16(static_cast<short>(0xDC00))))) };
+		if (lowMask != ((highMask << 2u) | carry))
+			break;
+		carry = highMask >> 30u;
+	}
+	return scalar::findInvalidUtf16((carry != 0u) ? (in - 1) : in, end);
+}
+
+} // namespace avx2
+
+
+
+// AVX-512 (F, BW and VL)
+// ASCII and BMP-only blocks are handled 512 bits at a time; everything else is passed to the SSE4.2 steps. searching and validating use the AVX2 kernels.
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized" // GCC 12's AVX-512 intrinsics use deliberately undefined values internally
+#endif // __GNUC__
+
+namespace avx512
+{
+
+YUTIYEFF_TARGET_AVX512 inline char* utf8FromUtf32(const char32_t* in, const char32_t* const end, char* out)
+{
+	while ((end - in) >= 64)
+	{
+		const __m512i codePoints0{ _mm512_loadu_si512(in) };
+		const __m512i codePoints1{ _mm512_loadu_si512(in + 16) };
+		const __m512i codePoints2{ _mm512_loadu_si512(in + 32) };
+		const __m512i codePoints3{ _mm512_loadu_si512(in + 48) };
+		const __m512i all{ _mm512_or_si512(_mm512_or_si512(codePoints0, codePoints1), _mm512_or_si512(codePoints2, codePoints3)) };
+		if (_mm512_test_epi32_mask(all, _mm512_set1_epi32(static_cast<int>(0xFFFFFF80))) != 0)
+		{
+			sse42::utf8FromUtf32Step(in, end, out);
+			continue;
+		}
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm512_cvtepi32_epi8(codePoints0));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16), _mm512_cvtepi32_epi8(codePoints1));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 32), _mm512_cvtepi32_epi8(codePoints2));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 48), _mm512_cvtepi32_epi8(codePoints3));
+		in += 64;
+		out += 64;
+	}
+	return avx2::utf8FromUtf32(in, end, out);
+}
+
+YUTIYEFF_TARGET_AVX512 inline char16_t* utf16FromUtf32(const char32_t* in, const char32_t* const end, char16_t* out)
+{
+	while ((end - in) >= 32)
+	{
+		const __m512i codePoints0{ _mm512_loadu_si512(in) };
+		const __m512i codePoints1{ _mm512_loadu_si512(in + 16) };
+		const __m512i topBits{ _mm512_set1_epi32(0xF800) };
+		const __m512i surrogate{ _mm512_set1_epi32(0xD800) };
+		const bool outOfRange{ _mm512_test_epi32_mask(_mm512_or_si512(codePoints0, codePoints1), _mm512_set1_epi32(static_cast<int>(0xFFFF0000))) != 0 };
+		const bool surrogates{ (_mm512_cmpeq_epi32_mask(_mm512_and_si512(codePoints0, topBits), surrogate) | _mm512_cmpeq_epi32_mask(_mm512_and_si512(codePoints1, topBits), surrogate)) != 0 };
+		if (outOfRange || surrogates)
+		{
+			sse42::utf16FromUtf32Step(in, end, out);
+			continue;
+		}
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm512_cvtepi32_epi16(codePoints0));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 16), _mm512_cvtepi32_epi16(codePoints1));
+		in += 32;
+		out += 32;
+	}
+	return avx2::utf16FromUtf32(in, end, out);
+}
+
+YUTIYEFF_TARGET_AVX512 inline char32_t* utf32FromUtf8(const char* in, const char* const end, char32_t* out)
+{
+	while ((end - in) >= 64)
+	{
+		const __m512i bytes{ _mm512_loadu_si512(in) };
+		if (_mm512_movepi8_mask(bytes) != 0)
+		{
+			sse42::utf32FromUtf8Step(in, end, out);
+			continue;
+		}
+		_mm512_storeu_si512(out, _mm512_cvtepu8_epi32(_mm512_castsi512_si128(bytes)));
+		_mm512_storeu_si512(out + 16, _mm512_cvtepu8_epi32(_mm512_extracti32x4_epi32(bytes, 1)));
+		_mm512_storeu_si512(out + 32, _mm512_cvtepu8_epi32(_mm512_extracti32x4_epi32(bytes, 2)));
+		_mm512_storeu_si512(out + 48, _mm512_cvtepu8_epi32(_mm512_extracti32x4_epi32(bytes, 3)));
+		in += 64;
+		out += 64;
+	}
+	return avx2::utf32FromUtf8(in, end, out);
+}
+
+YUTIYEFF_TARGET_AVX512 inline char32_t* utf32FromUtf16(const char16_t* in, const char16_t* const end, char32_t* out)
+{
+	while ((end - in) >= 32)
+	{
+		const __m512i units{ _mm512_loadu_si512(in) };
+		if (_mm512_cmpeq_epi16_mask(_mm512_and_si512(units, _mm512_set1_epi16(static_cast<short>(0xF800))), _mm512_set1_epi16(static_cast<short>(0xD800))) != 0)
+		{
+			sse42::utf32FromUtf16Step(in, end, out);
+			continue;
+		}
+		_mm512_storeu_si512(out, _mm512_cvtepu16_epi32(_mm512_castsi512_si256(units)));
+		_mm512_storeu_si512(out + 16, _mm512_cvtepu16_epi32(_mm512_extracti64x4_epi64(units, 1)));
+		in += 32;
+		out += 32;
+	}
+	return avx2::utf32FromUtf16(in, end, out);
+}
+
+YUTIYEFF_TARGET_AVX512 inline char* utf8FromUtf16(const char16_t* in, const char16_t* const end, char* out)
+{
+	while ((end - in) >= 64)
+	{
+		const __m512i units0{ _mm512_loadu_si512(in) };
+		const __m512i units1{ _mm512_loadu_si512(in + 32) };
+		if (_mm512_test_epi16_mask(_mm512_or_si512(units0, units1), _mm512_set1_epi16(static_cast<short>(0xFF80))) != 0)
+		{
+			sse42::utf8FromUtf16Step(in, end, out);
+			continue;
+		}
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm512_cvtepi16_epi8(units0));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 32), _mm512_cvtepi16_epi8(units1));
+		in += 64;
+		out += 64;
+	}
+	return avx2::utf8FromUtf16(in, end, out);
+}
+
+YUTIYEFF_TARGET_AVX512 inline char16_t* utf16FromUtf8(const char* in, const char* const end, char16_t* out)
+{
+	while ((end - in) >= 64)
+	{
+		const __m512i bytes{ _mm512_loadu_si512(in) };
+		if (_mm512_movepi8_mask(bytes) != 0)
+		{
+			sse42::utf16FromUtf8Step(in, end, out);
+			continue;
+		}
+		_mm512_storeu_si512(out, _mm512_cvtepu8_epi16(_mm512_castsi512_si256(bytes)));
+		_mm512_storeu_si512(out + 32, _mm512_cvtepu8_epi16(_mm512_extracti64x4_epi64(bytes, 1)));
+		in += 64;
+		out += 64;
+	}
+	return avx2::utf16FromUtf8(in, end, out);
+}
+
+YUTIYEFF_TARGET_AVX512 inline std::size_t codePointCountUtf8(const char* in, const char* const end)
+{
+	std::size_t count{ 0u };
+	while ((end - in) >= 64)
+	{
+		const std::size_t blockCount{ std::min(static_cast<std::size_t>(end - in) / 64u, std::size_t{ 255u }) };
+		__m512i continuations{ _mm512_setzero_si512() };
+		for (std::size_t i{ 0u }; i < blockCount; ++i, in += 64)
+			continuations = _mm512_mask_add_epi8(continuations, _mm512_cmplt_epi8_mask(_mm512_loadu_si512(in), _mm512_set1_epi8(-64)), continuations, _mm512_set1_epi8(1));
+		count += (blockCount * 64u) - static_cast<std::size_t>(_mm512_reduce_add_epi64(_mm512_sad_epu8(continuations, _mm512_setzero_si512())));
+	}
+	return count + avx2::codePointCountUtf8(in, end);
+}
+
+YUTIYEFF_TARGET_AVX512 inline std::size_t codePointCountUtf16(const char16_t* in, const char16_t* const end)
+{
+	std::size_t count{ 0u };
+	while ((end - in) >= 32)
+	{
+		const std::size_t blockCount{ std::min(static_cast<std::size_t>(end - in) / 32u, std::size_t{ 255u }) };
+		__m512i lowSurrogates{ _mm512_setzero_si512() };
+		for (std::size_t i{ 0u }; i < blockCount; ++i, in += 32)
+		{
+			const __m512i units{ _mm512_loadu_si512(in) };
+			lowSurrogates = _mm512_mask_add_epi16(lowSurrogates, _mm512_cmpeq_epi16_mask(_mm512_and_si512(units, _mm512_set1_epi16(static_cast<short>(0xFC00))), _mm512_set1_epi16(static_cast<short>(0xDC00))), lowSurrogates, _mm512_set1_epi16(1));
+		}
+		count += (blockCount * 32u) - static_cast<std::size_t>(_mm512_reduce_add_epi32(_mm512_madd_epi16(lowSurrogates, _mm512_set1_epi16(1))));
+	}
+	return count + avx2::codePointCountUtf16(in, end);
+}
+
+} // namespace avx512
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif // __GNUC__
+
+#endif // YUTIYEFF_SIMD_X86
+
+
+
+// DISPATCH
+
+struct KernelTable
+{
+	Kernel kernel;
+	char* (*utf8FromUtf32)(const char32_t*, const char32_t*, char*);
+	char16_t* (*utf16FromUtf32)(const char32_t*, const char32_t*, char16_t*);
+	char32_t* (*utf32FromUtf8)(const char*, const char*, char32_t*);
+	char32_t* (*utf32FromUtf16)(const char16_t*, const char16_t*, char32_t*);
+	char* (*utf8FromUtf16)(const char16_t*, const char16_t*, char*);
+	char16_t* (*utf16FromUtf8)(const char*, const char*, char16_t*);
+	std::size_t (*codePointCountUtf8)(const char*, const char*);
+	std::size_t (*codePointCountUtf16)(const char16_t*, const char16_t*);
+	const char* (*findUtf8)(const char*, const char*, const char*, std::size_t);
+	const char16_t* (*findUtf16)(const char16_t*, const char16_t*, const char16_t*, std::size_t);
+	const char* (*findInvalidUtf8)(const char*, const char*);
+	const char16_t* (*findInvalidUtf16)(const char16_t*, const char16_t*);
+};
+
+inline const KernelTable& kernelTable(const Kernel kernel)
+{
+	static const KernelTable scalarTable{ Kernel::Scalar, scalar::utf8FromUtf32, scalar::utf16FromUtf32, scalar::utf32FromUtf8, scalar::utf32FromUtf16, scalar::utf8FromUtf16, scalar::utf16FromUtf8, scalar::codePointCountUtf8, scalar::codePointCountUtf16, scalar::findUtf8, scalar::findUtf16, scalar::findInvalidUtf8, scalar::findInvalidUtf16 };
+#ifdef YUTIYEFF_SIMD_X86
+	static const KernelTable sse42Table{ Kernel::Sse42, sse42::utf8FromUtf32, sse42::utf16FromUtf32, sse42::utf32FromUtf8, sse42::utf32FromUtf16, sse42::utf8FromUtf16, sse42::utf16FromUtf8, sse42::codePointCountUtf8, sse42::codePointCountUtf16, sse42::findUtf8, sse42::findUtf16, sse42::findInvalidUtf8, sse42::findInvalidUtf16 };
+	static const KernelTable avx2Table{ Kernel::Avx2, avx2::utf8FromUtf32, avx2::utf16FromUtf32, avx2::utf32FromUtf8, avx2::utf32FromUtf16, avx2::utf8FromUtf16, avx2::utf16FromUtf8, avx2::codePointCountUtf8, avx2::codePointCountUtf16, avx2::findUtf8, avx2::findUtf16, avx2::findInvalidUtf8, avx2::findInvalidUtf16 };
+	static const KernelTable avx512Table{ Kernel::Avx512, avx512::utf8FromUtf32, avx512::utf16FromUtf32, avx512::utf32FromUtf8, avx512::utf32FromUtf16, avx512::utf8FromUtf16, avx512::utf16FromUtf8, avx512::codePointCountUtf8, avx512::codePointCountUtf16, avx2::findUtf8, avx2::findUtf16, avx2::findInvalidUtf8, avx2::findInvalidUtf16 };
+	switch (kernel)
+	{
+	case Kernel::Sse42:
+		return sse42Table;
+	case Kernel::Avx2:
+		return avx2Table;
+	case Kernel::Avx512:
+		return avx512Table;
+	default:
+		return scalarTable;
+	}
+#else
+	(void)kernel;
+	return scalarTable;
+#endif // YUTIYEFF_SIMD_X86
+}
+
+inline Kernel bestKernel()
+{
+#ifdef YUTIYEFF_SIMD_X86
+	const CpuFeatures& features{ cpuFeatures() };
+	if (features.avx512)
+		return Kernel::Avx512;
+	if (features.avx2)
+		return Kernel::Avx2;
+	if (features.sse42)
+		return Kernel::Sse42;
+#endif // YUTIYEFF_SIMD_X86
+	return Kernel::Scalar;
+}
+
+inline std::atomic<const KernelTable*>& activeKernelTable()
+{
+	static std::atomic<const KernelTable*> table{ &kernelTable(bestKernel()) };
+	return table;
+}
+
+inline const KernelTable& kernels()
+{
+	return *activeKernelTable().load(std::memory_order_relaxed);
+}
+
+inline char* utf8FromUtf32(const char32_t* const in, const char32_t* const end, char* const out) { return kernels().utf8FromUtf32(in, end, out); }
+inline char16_t* utf16FromUtf32(const char32_t* const in, const char32_t* const end, char16_t* const out) { return kernels().utf16FromUtf32(in, end, out); }
+inline char32_t* utf32FromUtf8(const char* const in, const char* const end, char32_t* const out) { return kernels().utf32FromUtf8(in, end, out); }
+inline char32_t* utf32FromUtf16(const char16_t* const in, const char16_t* const end, char32_t* const out) { return kernels().utf32FromUtf16(in, end, out); }
+inline char* utf8FromUtf16(const char16_t* const in, const char16_t* const end, char* const out) { return kernels().utf8FromUtf16(in, end, out); }
+inline char16_t* utf16FromUtf8(const char* const in, const char* const end, char16_t* const out) { return kernels().utf16FromUtf8(in, end, out); }
+inline std::size_t codePointCountUtf8(const char* const in, const char* const end) { return kernels().codePointCountUtf8(in, end); }
+inline std::size_t codePointCountUtf16(const char16_t* const in, const char16_t* const end) { return kernels().codePointCountUtf16(in, end); }
+inline const char* findUtf8(const char* const in, const char* const end, const char* const needle, const std::size_t needleLength) { return kernels().findUtf8(in, end, needle, needleLength); }
+inline const char16_t* findUtf16(const char16_t* const in, const char16_t* const end, const char16_t* const needle, const std::size_t needleLength) { return kernels().findUtf16(in, end, needle, needleLength); }
+inline const char* findInvalidUtf8(const char* const in, const char* const end) { return kernels().findInvalidUtf8(in, end); }
+inline const char16_t* findInvalidUtf16(const char16_t* const in, const char16_t* const end) { return kernels().findInvalidUtf16(in, end); }
+
+// the same, chosen by code unit type (UTF-32 needs no kernel for these as each code unit is a code point)
+inline std::size_t codePointCount(const char* const in, const char* const end) { return codePointCountUtf8(in, end); }
+inline std::size_t codePointCount(const char16_t* const in, const char16_t* const end) { return codePointCountUtf16(in, end); }
+inline std::size_t codePointCount(const char32_t* const in, const char32_t* const end) { return static_cast<std::size_t>(end - in); }
+inline const char* findSequence(const char* const in, const char* const end, const char* const needle, const std::size_t needleLength) { return findUtf8(in, end, needle, needleLength); }
+inline const char16_t* findSequence(const char16_t* const in, const char16_t* const end, const char16_t* const needle, const std::size_t needleLength) { return findUtf16(in, end, needle, needleLength); }
+inline const char32_t* findSequence(const char32_t* const in, const char32_t* const end, const char32_t* const needle, const std::size_t needleLength) { return scalar::findUnits(in, end, needle, needleLength); }
+inline const char* findInvalid(const char* const in, const char* const end) { return findInvalidUtf8(in, end); }
+inline const char16_t* findInvalid(const char16_t* const in, const char16_t* const end) { return findInvalidUtf16(in, end); }
+inline const char32_t* findInvalid(const char32_t* const in, const char32_t* const end) { return scalar::findInvalid(in, end); }
+
+// the conversion kernels write their result at "out" and return its end but the SIMD kernels also store whole vectors, so they can write
+// (but not produce) up to a vector past that end. the widest store is 64 bytes (AVX-512) so "out" must have room for the converted length
+// (see convertedLength) and this many code units more. room of exactly the converted length needs transcodeOrCopyExactly, which writes only what it produces
+template <class OutT>
+constexpr std::size_t kernelOverrun()
+{
+	return 64u / sizeof(OutT);
+}
+
+inline char* transcode(const char32_t* const in, const char32_t* const end, char* const out) { return utf8FromUtf32(in, end, out); }
+inline char16_t* transcode(const char32_t* const in, const char32_t* const end, char16_t* const out) { return utf16FromUtf32(in, end, out); }
+inline char32_t* transcode(const char* const in, const char* const end, char32_t* const out) { return utf32FromUtf8(in, end, out); }
+inline char32_t* transcode(const char16_t* const in, const char16_t* const end, char32_t* const out) { return utf32FromUtf16(in, end, out); }
+inline char* transcode(const char16_t* const in, const char16_t* const end, char* const out) { return utf8FromUtf16(in, end, out); }
+inline char16_t* transcode(const char* const in, const char* const end, char16_t* const out) { return utf16FromUtf8(in, end, out); }
+
+// converts a sequence (which is only copied if it is already in the output encoding)
+template <class CharT>
+inline CharT* transcodeOrCopy(const CharT* const in, const CharT* const end, CharT* const out)
+{
+	const std::size_t size{ static_cast<std::size_t>(end - in) };
+	std::char_traits<CharT>::copy(out, in, size);
+	return out + size;
+}
+
+template <class OutT, class InT>
+inline OutT* transcodeOrCopy(const InT* const in, const InT* const end, OutT* const out)
+{
+	return transcode(in, end, out);
+}
+
+// converts a sequence, writing only what it produces (so it can be converted into room of exactly the converted length)
+template <class CharT>
+inline CharT* transcodeOrCopyExactly(const CharT* const in, const CharT* const end, CharT* const out)
+{
+	return transcodeOrCopy(in, end, out);
+}
+
+template <class OutT, class InT>
+inline OutT* transcodeOrCopyExactly(const InT* const in, const InT* const end, OutT* const out)
+{
+	return scalar::transcode(in, end, out);
+}
+
+// the first occurrence of a (non-empty) needle that is made of whole code points or "end" if there is none
+template <class CharT>
+inline const CharT* findCodePoints(const CharT* const begin, const CharT* const end, const CharT* const needle, const std::size_t needleLength)
+{
+	for (const CharT* from{ begin }; from != end; ++from)
+	{
+		const CharT* const match{ findSequence(from, end, needle, needleLength) };
+		if (match == end)
+			break;
+		const CharT* const matchEnd{ match + needleLength };
+		if (isCodePointStart(*match) && ((matchEnd == end) || isCodePointStart(*matchEnd)))
+			return match;
+		from = match;
+	}
+	return end;
+}
+
+// the number of code units that converting a sequence produces, without decoding it. this is exact for valid input and never too small
+// for invalid input (each sequence that is decoded needs its lead code unit and only those that start with a surrogate or a 4-byte lead
+// can produce a code point above 0xFFFF)
+// (a sequence that is already in the output encoding is only copied)
+template <class CharT>
+inline std::size_t convertedLength(const CharT* const in, const CharT* const end, CharT)
+{
+	return static_cast<std::size_t>(end - in);
+}
+
+inline std::size_t convertedLength(const char* in, const char* const end, char32_t)
+{
+	return codePointCountUtf8(in, end);
+}
+
+inline std::size_t convertedLength(const char* in, const char* const end, char16_t)
+{
+	std::size_t fourByteLeadCount{ 0u };
+	for (const char* current{ in }; current != end; ++current)
+		fourByteLeadCount += (static_cast<unsigned char>(*current) >= 0xF0) ? 1u : 0u;
+	return codePointCountUtf8(in, end) + fourByteLeadCount;
+}
+
+inline std::size_t convertedLength(const char16_t* in, const char16_t* const end, char32_t)
+{
+	// every valid surrogate pair makes one code point from two code units
+	std::size_t pairCount{ 0u };
+	for (const char16_t* current{ in }; (end - current) > 1; ++current)
+		pairCount += (((current[0] & 0xFC00) == 0xD800) && ((current[1] & 0xFC00) == 0xDC00)) ? 1u : 0u;
+	return static_cast<std::size_t>(end - in) - pairCount;
+}
+
+inline std::size_t convertedLength(const char16_t* in, const char16_t* const end, char)
+{
+	// a surrogate pair makes four bytes so each surrogate counts as two
+	std::size_t length{ 0u };
+	for (; in != end; ++in)
+		length += 1u + ((*in >= 0x80) ? 1u : 0u) + (((*in >= 0x800) && ((*in & 0xF800) != 0xD800)) ? 1u : 0u);
+	return length;
+}
+
+inline std::size_t convertedLength(const char32_t* in, const char32_t* const end, char)
+{
+	std::size_t length{ 0u };
+	for (; in != end; ++in)
+		length += 1u + ((*in >= 0x80) ? 1u : 0u) + ((*in >= 0x800) ? 1u : 0u) + ((*in >= 0x10000) ? 1u : 0u);
+	return length;
+}
+
+inline std::size_t convertedLength(const char32_t* in, const char32_t* const end, char16_t)
+{
+	std::size_t length{ static_cast<std::size_t>(end - in) };
+	for (; in != end; ++in)
+		length += (*in >= 0x10000) ? 1u : 0u;
+	return length;
+}
+
+// converts a whole sequence into a string that is sized from "convertedLength" (and the kernel overrun) instead of the worst case
+template <class OutT, class InT>
+inline std::basic_string<OutT> convertStringExactly(const InT* const in, const InT* const end)
+{
+	std::basic_string<OutT> result(convertedLength(in, end, OutT{}) + kernelOverrun<OutT>(), OutT{});
+	const OutT* const resultEnd{ transcode(in, end, &result[0]) };
+	result.resize(static_cast<std::size_t>(resultEnd - result.data()));
+	countTranscode<OutT, InT>(static_cast<std::size_t>(end - in));
+	countAllocation(result);
+	return result;
+}
+
+// a sequence of any encoding as UTF-8
+inline std::string utf8String(const char* const in, const char* const end) { return std::string(in, end); }
+inline std::string utf8String(const char16_t* const in, const char16_t* const end) { return convertStringExactly<char>(in, end); }
+inline std::string utf8String(const char32_t* const in, const char32_t* const end) { return convertStringExactly<char>(in, end); }
+
+// a sequence (that is valid) in another encoding (or a copy of it if it is already in that encoding)
+template <class CharT>
+inline std::basic_string<CharT> sequenceOf(const CharT* const in, const CharT* const end, CharT)
+{
+	return std::basic_string<CharT>(in, end);
+}
+
+template <class OutT, class InT>
+inline std::basic_string<OutT> sequenceOf(const InT* const in, const InT* const end, OutT)
+{
+	return convertStringExactly<OutT>(in, end);
+}
+
+// a copy (using the allocator) of a sequence with each invalid part (from "firstInvalid" onwards) replaced by U+FFFD or removed
+template <class CharT, class Allocator = std::allocator<CharT>>
+inline std::basic_string<CharT, std::char_traits<CharT>, Allocator> repairedSequence(const CharT* in, const CharT* const end, const CharT* invalid, const bool isReplacing, const Allocator& allocator = Allocator())
+{
+	CharT replacement[4];
+	CharT* replacementEnd{ replacement };
+	encode(0xFFFD, replacementEnd);
+
+	std::basic_string<CharT, std::char_traits<CharT>, Allocator> result(allocator);
+	result.reserve(static_cast<std::size_t>(end - in));
+	while (invalid != end)
+	{
+		result.append(in, invalid);
+		in = invalid;
+		checkSequence(in, end); // moves past the invalid part
+		if (isReplacing)
+			result.append(replacement, replacementEnd);
+		invalid = findInvalid(in, end);
+	}
+	result.append(in, end);
+	return result;
+}
+
+// the first invalid part of a sequence (or "end" if it is valid or the policy says not to check) and its offset, which is npos if there is none.
+// with Throw, an invalid part throws InvalidSequence instead (so the callers only see valid sequences, as with AssumeValid)
+template <class CharT>
+inline const CharT* checkedInvalid(const CharT* const in, const CharT* const end, const ErrorPolicy errorPolicy, std::size_t* const errorOffset)
+{
+	const CharT* const invalid{ (errorPolicy == ErrorPolicy::AssumeValid) ? end : findInvalid(in, end) };
+	if (errorOffset != nullptr)
+		*errorOffset = (invalid != end) ? static_cast<std::size_t>(invalid - in) : std::basic_string<CharT>::npos;
+	if ((invalid != end) && (errorPolicy == ErrorPolicy::Throw))
+		throw InvalidSequence(static_cast<std::size_t>(invalid - in));
+	return invalid;
+}
+
+// a sequence in any encoding as a valid sequence in the output encoding (according to the error policy)
+template <class OutT, class InT>
+inline std::basic_string<OutT> validSequence(const InT* const in, const InT* const end, const ErrorPolicy errorPolicy = ErrorPolicy::Replace, std::size_t* const errorOffset = nullptr)
+{
+	const InT* const invalid{ checkedInvalid(in, end, errorPolicy, errorOffset) };
+	if (invalid == end)
+		return sequenceOf(in, end, OutT{});
+	if (errorPolicy == ErrorPolicy::Stop)
+		return std::basic_string<OutT>();
+	const std::basic_string<InT> repaired{ repairedSequence(in, end, invalid, errorPolicy == ErrorPolicy::Replace) };
+	return sequenceOf(repaired.data(), repaired.data() + repaired.size(), OutT{});
+}
+
+// the same for a sequence that is already in the output encoding, which is kept (without copying) if it is valid
+template <class CharT>
+inline std::basic_string<CharT> validSequence(std::basic_string<CharT>&& sequence, const ErrorPolicy errorPolicy = ErrorPolicy::Replace, std::size_t* const errorOffset = nullptr)
+{
+	const CharT* const in{ sequence.data() };
+	const CharT* const end{ in + sequence.size() };
+	const CharT* const invalid{ checkedInvalid(in, end, errorPolicy, errorOffset) };
+	if (invalid == end)
+		return std::move(sequence);
+	if (errorPolicy == ErrorPolicy::Stop)
+		return std::basic_string<CharT>();
+	return repairedSequence(in, end, invalid, errorPolicy == ErrorPolicy::Replace);
+}
+
+} // namespace priv
+
+inline bool isKernelSupported(const Kernel kernel)
+{
+	switch (kernel)
+	{
+	case Kernel::Automatic:
+	case Kernel::Scalar:
+		return true;
+#ifdef YUTIYEFF_SIMD_X86
+	case Kernel::Sse42:
+		return priv::cpuFeatures().sse42;
+	case Kernel::Avx2:
+		return priv::cpuFeatures().avx2;
+	case Kernel::Avx512:
+		return priv::cpuFeatures().avx512;
+#endif // YUTIYEFF_SIMD_X86
+	default:
+		return false;
+	}
+}
+
+inline bool setKernel(const Kernel kernel)
+{
+	if (!isKernelSupported(kernel))
+		return false;
+	priv::activeKernelTable().store(&priv::kernelTable((kernel == Kernel::Automatic) ? priv::bestKernel() : kernel), std::memory_order_relaxed);
+	return true;
+}
+
+inline Kernel getKernel()
+{
+	return priv::kernels().kernel;
+}
+
+} // namespace yutiyeff
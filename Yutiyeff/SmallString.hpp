@@ -0,0 +1,194 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Yutiyeff (https://github.com/Hapaxia/Yutiyeff)
+//
+// Copyright(c) 2023-2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#ifdef YUTIYEFF_CPP17
+#include <memory_resource>
+#endif // YUTIYEFF_CPP17
+
+#include "CodePointIterator.hpp"
+#include "StringView.hpp"
+
+namespace yutiyeff
+{
+
+// a string (UTF-8, UTF-16 or UTF-32, by code unit type) that keeps a sequence of up to "inlineCapacity" code units inside itself so that short strings
+// never allocate. longer sequences are moved to storage from the allocator. it has no virtual functions and the same operations (and conversions) as the other string types.
+// as with the other string types, a sequence is checked when the string is created from it (see ErrorPolicy) so the string is always valid
+template <class CharT, std::size_t inlineCapacity, class Allocator = std::allocator<CharT>>
+class SmallString
+{
+	static_assert(inlineCapacity > 0u, "the inline capacity must be at least one code unit");
+
+public:
+	using allocator_type = Allocator;
+	using const_iterator = CodePointIterator<CharT>;
+	using iterator = const_iterator;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+	using reverse_iterator = const_reverse_iterator;
+
+	SmallString() = default;
+	explicit SmallString(const Allocator& allocator);
+	SmallString(const char* cU8String, const Allocator& allocator = Allocator());
+	SmallString(const char cU8, const Allocator& allocator = Allocator());
+#ifdef YUTIYEFF_CPP20
+	SmallString(const char8_t* cU8String, const Allocator& allocator = Allocator());
+	SmallString(const char8_t cU8, const Allocator& allocator = Allocator());
+	SmallString(const std::basic_string<char8_t>& u8String, const Allocator& allocator = Allocator());
+#endif // YUTIYEFF_CPP20
+	SmallString(const char16_t* cU16String, const Allocator& allocator = Allocator());
+	SmallString(const char16_t cU16, const Allocator& allocator = Allocator());
+	SmallString(const char32_t* cU32String, const Allocator& allocator = Allocator());
+	SmallString(const char32_t cU32, const Allocator& allocator = Allocator());
+	template <class InCharT, class InAllocator>
+	SmallString(const std::basic_string<InCharT, std::char_traits<InCharT>, InAllocator>& sequence, const Allocator& allocator = Allocator());
+	template <class InCharT>
+	SmallString(const StringView<InCharT>& view, const Allocator& allocator = Allocator());
+	template <class T, class InCharT>
+	SmallString(const String<T, InCharT>& string, const Allocator& allocator = Allocator()); // not checked again
+	template <class InCharT, std::size_t otherInlineCapacity, class OtherAllocator>
+	SmallString(const SmallString<InCharT, otherInlineCapacity, OtherAllocator>& smallString, const Allocator& allocator = Allocator()); // not checked again
+	SmallString(const SmallString& smallString);
+	SmallString(const SmallString& smallString, const Allocator& allocator);
+	SmallString(SmallString&& smallString) noexcept;
+	~SmallString();
+
+	// see String::fromSequence
+	template <class InCharT>
+	static SmallString fromSequence(const StringView<InCharT>& sequence, ErrorPolicy errorPolicy, std::size_t* errorOffset = nullptr, const Allocator& allocator = Allocator());
+
+	SmallString& operator=(const SmallString& smallString);
+	SmallString& operator=(SmallString&& smallString) noexcept(std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value);
+	SmallString operator+(const SmallString& smallString) const;
+	SmallString& operator+=(const SmallString& smallString);
+
+	std::string getString() const; // get a standard std::string representing the UTF-8 formatted version of the string
+	std::string getNonUnicodeString() const; // get a standard std::string of only the codes in the 0-127 range
+	std::size_t length() const;
+
+	char32_t operator[](std::size_t index) const;
+	void clear();
+
+	std::size_t find(const SmallString& smallString, std::size_t offset = 0u) const;
+	SmallString substr(std::size_t length, std::size_t offset = 0u) const;
+	void insert(std::size_t offset, const SmallString& smallString);
+	void insert(std::size_t offset, char32_t char32);
+	void erase(std::size_t startPos, std::size_t length = 0u);
+	void set(std::size_t index, char32_t char32);
+
+	void reserve(std::size_t dataPointsCap);
+
+	bool empty() const { return m_size == 0u; }
+	std::size_t size() const { return length(); }
+	bool isInline() const { return m_heap.units == nullptr; } // whether the sequence is stored inside the string (rather than in storage from the allocator)
+	Allocator getAllocator() const { return m_heap; }
+
+	void swap(SmallString& other);
+
+	StringView<CharT> getView() const { return StringView<CharT>(priv_data(), m_size); } // the view is invalidated by any change to the string
+	operator StringView<CharT>() const { return getView(); }
+
+	const CharT* getData() const { return priv_data(); }
+	std::size_t getDataSize() const { return m_size; } // in code units
+	std::basic_string<CharT> getSequence() const { return std::basic_string<CharT>(priv_data(), m_size); } // copies the sequence
+
+	const_iterator begin() const { return getView().begin(); }
+	const_iterator end() const { return getView().end(); }
+	const_iterator cbegin() const { return begin(); }
+	const_iterator cend() const { return end(); }
+	const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+	const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+	const_reverse_iterator crbegin() const { return rbegin(); }
+	const_reverse_iterator crend() const { return rend(); }
+
+private:
+	using AllocatorTraits = std::allocator_traits<Allocator>;
+
+	// the storage from the allocator (only while the sequence does not fit inside). the allocator is its base so an empty allocator takes no room
+	struct Heap : Allocator
+	{
+		Heap() = default;
+		explicit Heap(const Allocator& allocator) : Allocator(allocator) { }
+		CharT* units{ nullptr };
+	};
+
+	CharT m_inline[inlineCapacity];
+	Heap m_heap;
+	std::size_t m_capacity{ inlineCapacity };
+	std::size_t m_size{ 0u };
+
+	CharT* priv_data() { return (m_heap.units != nullptr) ? m_heap.units : m_inline; }
+	const CharT* priv_data() const { return (m_heap.units != nullptr) ? m_heap.units : m_inline; }
+	Allocator& priv_allocator() { return m_heap; }
+	void priv_release(); // gives back the storage from the allocator (if there is any)
+	void priv_propagate(const Allocator& allocator, std::true_type); // takes the allocator (as the allocator's traits ask for on assignment)
+	void priv_propagate(const Allocator& allocator, std::false_type); // keeps its own allocator
+	void priv_setHeap(CharT* units, std::size_t capacity); // takes over storage from the allocator (releasing any that it had)
+	CharT* priv_prepare(std::size_t capacity); // empties the string and makes room for (at least) "capacity" code units
+	void priv_assign(const CharT* in, const CharT* end);
+	template <class InCharT>
+	void priv_assign(const InCharT* in, const InCharT* end); // converts (a valid sequence)
+	template <class InCharT>
+	void priv_assignChecked(const InCharT* in, const InCharT* end, ErrorPolicy errorPolicy, std::size_t* errorOffset);
+	void priv_replace(std::size_t start, std::size_t length, const CharT* units, std::size_t count, std::size_t minimumCapacity = 0u); // replaces code units (keeping the rest)
+	std::size_t priv_codePointOffset(std::size_t index) const;
+	std::size_t priv_insertOffset(std::size_t index) const; // throws std::out_of_range if the index is past the end
+};
+
+template <std::size_t inlineCapacity = 32u>
+using SmallUtf8String = SmallString<char, inlineCapacity>;
+template <std::size_t inlineCapacity = 16u>
+using SmallUtf16String = SmallString<char16_t, inlineCapacity>;
+template <std::size_t inlineCapacity = 8u>
+using SmallUtf32String = SmallString<char32_t, inlineCapacity>;
+
+#ifdef YUTIYEFF_CPP17
+// small strings that use a memory resource (e.g. std::pmr::monotonic_buffer_resource) for sequences that do not fit inside
+namespace pmr
+{
+
+template <std::size_t inlineCapacity = 32u>
+using SmallUtf8String = SmallString<char, inlineCapacity, std::pmr::polymorphic_allocator<char>>;
+template <std::size_t inlineCapacity = 16u>
+using SmallUtf16String = SmallString<char16_t, inlineCapacity, std::pmr::polymorphic_allocator<char16_t>>;
+template <std::size_t inlineCapacity = 8u>
+using SmallUtf32String = SmallString<char32_t, inlineCapacity, std::pmr::polymorphic_allocator<char32_t>>;
+
+} // namespace pmr
+#endif // YUTIYEFF_CPP17
+
+} // namespace yutiyeff
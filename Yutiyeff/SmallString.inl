@@ -0,0 +1,489 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Yutiyeff (https://github.com/Hapaxia/Yutiyeff)
+//
+// Copyright(c) 2023-2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+
+#pragma once
+
+#include "SmallString.hpp"
+
+#include <functional>
+#include <stdexcept>
+
+namespace yutiyeff
+{
+
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+inline SmallString<CharT, inlineCapacity, Allocator>::SmallString(const char* cU8String, const Allocator& allocator)
+	: SmallString(Utf8StringView(cU8String), allocator)
+{
+}
+
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+inline SmallString<CharT, inlineCapacity, Allocator>::SmallString(const char cU8, const Allocator& allocator)
+	: SmallString(Utf8StringView(&cU8, 1u), allocator)
+{
+}
+
+#ifdef YUTIYEFF_CPP20
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+inline SmallString<CharT, inlineCapacity, Allocator>::SmallString(const char8_t* cU8String, const Allocator& allocator)
+	: SmallString(Utf8StringView(reinterpret_cast<const char*>(cU8String)), allocator)
+{
+}
+
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+inline SmallString<CharT, inlineCapacity, Allocator>::SmallString(const char8_t cU8, const Allocator& allocator)
+	: SmallString(Utf8StringView(reinterpret_cast<const char*>(&cU8), 1u), allocator)
+{
+}
+
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+inline SmallString<CharT, inlineCapacity, Allocator>::SmallString(const std::basic_string<char8_t>& u8String, const Allocator& allocator)
+	: SmallString(Utf8StringView(reinterpret_cast<const char*>(u8String.data()), u8String.size()), allocator)
+{
+}
+#endif // YUTIYEFF_CPP20
+
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+inline SmallString<CharT, inlineCapacity, Allocator>::SmallString(const char16_t* cU16String, const Allocator& allocator)
+	: SmallString(Utf16StringView(cU16String), allocator)
+{
+}
+
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+inline SmallString<CharT, inlineCapacity, Allocator>::SmallString(const char16_t cU16, const Allocator& allocator)
+	: SmallString(Utf16StringView(&cU16, 1u), allocator)
+{
+}
+
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+inline SmallString<CharT, inlineCapacity, Allocator>::SmallString(const char32_t* cU32String, const Allocator& allocator)
+	: SmallString(Utf32StringView(cU32String), allocator)
+{
+}
+
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+inline SmallString<CharT, inlineCapacity, Allocator>::SmallString(const char32_t cU32, const Allocator& allocator)
+	: SmallString(Utf32StringView(&cU32, 1u), allocator)
+{
+}
+
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+template <class InCharT, class InAllocator>
+inline SmallString<CharT, inlineCapacity, Allocator>::SmallString(const std::basic_string<InCharT, std::char_traits<InCharT>, InAllocator>& sequence, const Allocator& allocator)
+	: SmallString(StringView<InCharT>(sequence.data(), sequence.size()), allocator)
+{
+}
+
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+template <class InCharT>
+inline SmallString<CharT, inlineCapacity, Allocator>::SmallString(const StringView<InCharT>& view, const Allocator& allocator)
+	: m_heap(allocator)
+{
+	priv_assignChecked(view.getData(), view.getData() + view.getDataSize(), ErrorPolicy::Replace, nullptr);
+}
+
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+template <class T, class InCharT>
+inline SmallString<CharT, inlineCapacity, Allocator>::SmallString(const String<T, InCharT>& string, const Allocator& allocator)
+	: m_heap(allocator)
+{
+	const StringView<InCharT> view{ string.getView() };
+	priv_assign(view.getData(), view.getData() + view.getDataSize());
+}
+
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+template <class InCharT, std::size_t otherInlineCapacity, class OtherAllocator>
+inline SmallString<CharT, inlineCapacity, Allocator>::SmallString(const SmallString<InCharT, otherInlineCapacity, OtherAllocator>& smallString, const Allocator& allocator)
+	: m_heap(allocator)
+{
+	priv_assign(smallString.getData(), smallString.getData() + smallString.getDataSize());
+}
+
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+inline SmallString<CharT, inlineCapacity, Allocator>::SmallString(const Allocator& allocator)
+	: m_heap(allocator)
+{
+}
+
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+inline SmallString<CharT, inlineCapacity, Allocator>::SmallString(const SmallString& smallString)
+	: SmallString(smallString, AllocatorTraits::select_on_container_copy_construction(smallString.m_heap))
+{
+}
+
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+inline SmallString<CharT, inlineCapacity, Allocator>::SmallString(const SmallString& smallString, const Allocator& allocator)
+	: m_heap(allocator)
+{
+	priv_assign(smallString.priv_data(), smallString.priv_data() + smallString.m_size);
+}
+
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+inline SmallString<CharT, inlineCapacity, Allocator>::SmallString(SmallString&& smallString) noexcept
+	: m_heap(static_cast<const Allocator&>(smallString.m_heap))
+{
+	if (smallString.m_heap.units != nullptr)
+	{
+		m_heap.units = smallString.m_heap.units;
+		m_capacity = smallString.m_capacity;
+		smallString.m_heap.units = nullptr;
+		smallString.m_capacity = inlineCapacity;
+	}
+	else
+		std::char_traits<CharT>::copy(m_inline, smallString.m_inline, smallString.m_size);
+	m_size = smallString.m_size;
+	smallString.m_size = 0u;
+}
+
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+inline SmallString<CharT, inlineCapacity, Allocator>::~SmallString()
+{
+	priv_release();
+}
+
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+template <class InCharT>
+inline SmallString<CharT, inlineCapacity, Allocator> SmallString<CharT, inlineCapacity, Allocator>::fromSequence(const StringView<InCharT>& sequence, const ErrorPolicy errorPolicy, std::size_t* const errorOffset, const Allocator& allocator)
+{
+	SmallString result{ allocator };
+	result.priv_assignChecked(sequence.getData(), sequence.getData() + sequence.getDataSize(), errorPolicy, errorOffset);
+	return result;
+}
+
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+inline SmallString<CharT, inlineCapacity, Allocator>& SmallString<CharT, inlineCapacity, Allocator>::operator=(const SmallString& smallString)
+{
+	if (&smallString == this)
+		return *this;
+	if (priv_allocator() != smallString.m_heap)
+		priv_propagate(smallString.m_heap, typename AllocatorTraits::propagate_on_container_copy_assignment{});
+	priv_assign(smallString.priv_data(), smallString.priv_data() + smallString.m_size);
+	return *this;
+}
+
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+inline SmallString<CharT, inlineCapacity, Allocator>& SmallString<CharT, inlineCapacity, Allocator>::operator=(SmallString&& smallString) noexcept(std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value)
+{
+	if (&smallString == this)
+		return *this;
+	if (priv_allocator() != smallString.m_heap)
+		priv_propagate(smallString.m_heap, typename AllocatorTraits::propagate_on_container_move_assignment{});
+	if ((smallString.m_heap.units != nullptr) && (priv_allocator() == smallString.m_heap))
+	{
+		priv_setHeap(smallString.m_heap.units, smallString.m_capacity);
+		m_size = smallString.m_size;
+		smallString.m_heap.units = nullptr;
+		smallString.m_capacity = inlineCapacity;
+	}
+	else // an inline sequence (or one from another allocator, which cannot be taken over) is copied
+		priv_assign(smallString.priv_data(), smallString.priv_data() + smallString.m_size);
+	smallString.m_size = 0u;
+	return *this;
+}
+
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+inline SmallString<CharT, inlineCapacity, Allocator> SmallString<CharT, inlineCapacity, Allocator>::operator+(const SmallString& smallString) const
+{
+	SmallString result{ getAllocator() }; // the same allocator (rather than the one that a copy would have) so that an arena keeps every part of its strings
+	CharT* const data{ result.priv_prepare(m_size + smallString.m_size) };
+	std::char_traits<CharT>::copy(data, priv_data(), m_size);
+	std::char_traits<CharT>::copy(data + m_size, smallString.priv_data(), smallString.m_size);
+	result.m_size = m_size + smallString.m_size;
+	return result;
+}
+
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+inline SmallString<CharT, inlineCapacity, Allocator>& SmallString<CharT, inlineCapacity, Allocator>::operator+=(const SmallString& smallString)
+{
+	priv_replace(m_size, 0u, smallString.priv_data(), smallString.m_size);
+	return *this;
+}
+
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+inline std::string SmallString<CharT, inlineCapacity, Allocator>::getString() const
+{
+	const priv::StatsScope statsScope{ StatsOperation::Output };
+	return priv::utf8String(priv_data(), priv_data() + m_size);
+}
+
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+inline std::string SmallString<CharT, inlineCapacity, Allocator>::getNonUnicodeString() const
+{
+	const priv::StatsScope statsScope{ StatsOperation::Output };
+	return priv::nonUnicodeString(priv_data(), priv_data() + m_size);
+}
+
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+inline std::size_t SmallString<CharT, inlineCapacity, Allocator>::length() const
+{
+	return priv::codePointCount(priv_data(), priv_data() + m_size);
+}
+
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+inline char32_t SmallString<CharT, inlineCapacity, Allocator>::operator[](const std::size_t index) const
+{
+	const std::size_t offset{ priv_codePointOffset(index) };
+	return (offset != m_size) ? priv::validCodePointAt(priv_data() + offset) : 0u;
+}
+
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+inline void SmallString<CharT, inlineCapacity, Allocator>::clear()
+{
+	m_size = 0u;
+}
+
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+inline std::size_t SmallString<CharT, inlineCapacity, Allocator>::find(const SmallString& smallString, const std::size_t offset) const
+{
+	if (smallString.empty())
+		return (offset <= length()) ? offset : std::basic_string<CharT>::npos;
+
+	const CharT* const begin{ priv_data() + priv_codePointOffset(offset) };
+	const CharT* const end{ priv_data() + m_size };
+	const CharT* const match{ priv::findSequence(begin, end, smallString.priv_data(), smallString.m_size) }; // both are valid so any match is of whole code points
+	return (match != end) ? (offset + priv::codePointCount(begin, match)) : std::basic_string<CharT>::npos;
+}
+
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+inline SmallString<CharT, inlineCapacity, Allocator> SmallString<CharT, inlineCapacity, Allocator>::substr(const std::size_t length, const std::size_t offset) const
+{
+	const CharT* const begin{ priv_data() + priv_codePointOffset(offset) };
+	SmallString result{ getAllocator() }; // see operator+
+	result.priv_assign(begin, priv::findCodePoint(begin, priv_data() + m_size, length));
+	return result;
+}
+
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+inline void SmallString<CharT, inlineCapacity, Allocator>::insert(const std::size_t offset, const SmallString& smallString)
+{
+	priv_replace(priv_insertOffset(offset), 0u, smallString.priv_data(), smallString.m_size);
+}
+
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+inline void SmallString<CharT, inlineCapacity, Allocator>::insert(const std::size_t offset, const char32_t char32)
+{
+	const std::size_t insertOffset{ priv_insertOffset(offset) };
+	if (!priv::isValidCodePoint(char32)) // discarded, as it is by the other types
+		return;
+	CharT encoded[4];
+	CharT* encodedEnd{ encoded };
+	priv::encode(char32, encodedEnd);
+	priv_replace(insertOffset, 0u, encoded, static_cast<std::size_t>(encodedEnd - encoded));
+}
+
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+inline void SmallString<CharT, inlineCapacity, Allocator>::erase(const std::size_t startPos, const std::size_t length)
+{
+	const std::size_t start{ priv_codePointOffset(startPos) };
+	const CharT* const begin{ priv_data() + start };
+	const CharT* const end{ (length == 0u) ? (priv_data() + m_size) : priv::findCodePoint(begin, priv_data() + m_size, length) };
+	priv_replace(start, static_cast<std::size_t>(end - begin), begin, 0u);
+}
+
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+inline void SmallString<CharT, inlineCapacity, Allocator>::set(const std::size_t index, const char32_t char32)
+{
+	const std::size_t start{ priv_codePointOffset(index) };
+	if (start == m_size)
+		return;
+	const CharT* const begin{ priv_data() + start };
+	const std::size_t length{ static_cast<std::size_t>(priv::findCodePoint(begin, priv_data() + m_size, 1u) - begin) };
+	CharT encoded[4];
+	CharT* encodedEnd{ encoded };
+	if (priv::isValidCodePoint(char32)) // otherwise, the code point is removed (as it is by the other types)
+		priv::encode(char32, encodedEnd);
+	priv_replace(start, length, encoded, static_cast<std::size_t>(encodedEnd - encoded));
+}
+
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+inline void SmallString<CharT, inlineCapacity, Allocator>::reserve(const std::size_t dataPointsCap)
+{
+	const std::size_t capacity{ dataPointsCap * (4u / sizeof(CharT)) };
+	if (capacity > m_capacity)
+		priv_replace(m_size, 0u, priv_data(), 0u, capacity);
+}
+
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+inline void SmallString<CharT, inlineCapacity, Allocator>::swap(SmallString& other)
+{
+	SmallString temp{ std::move(other) };
+	other = std::move(*this);
+	*this = std::move(temp);
+}
+
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+inline void SmallString<CharT, inlineCapacity, Allocator>::priv_release()
+{
+	if (m_heap.units == nullptr)
+		return;
+	AllocatorTraits::deallocate(priv_allocator(), m_heap.units, m_capacity);
+	m_heap.units = nullptr;
+	m_capacity = inlineCapacity;
+}
+
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+inline void SmallString<CharT, inlineCapacity, Allocator>::priv_propagate(const Allocator& allocator, std::true_type)
+{
+	priv_release(); // the storage must be given back to the allocator that it came from
+	priv_allocator() = allocator;
+}
+
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+inline void SmallString<CharT, inlineCapacity, Allocator>::priv_propagate(const Allocator&, std::false_type)
+{
+}
+
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+inline void SmallString<CharT, inlineCapacity, Allocator>::priv_setHeap(CharT* const units, const std::size_t capacity)
+{
+	priv_release();
+	m_heap.units = units;
+	m_capacity = capacity;
+}
+
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+inline CharT* SmallString<CharT, inlineCapacity, Allocator>::priv_prepare(const std::size_t capacity)
+{
+	m_size = 0u;
+	if (capacity > m_capacity)
+		priv_setHeap(AllocatorTraits::allocate(priv_allocator(), capacity), capacity);
+	return priv_data();
+}
+
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+inline void SmallString<CharT, inlineCapacity, Allocator>::priv_assign(const CharT* const in, const CharT* const end)
+{
+	const std::size_t size{ static_cast<std::size_t>(end - in) };
+	std::char_traits<CharT>::copy(priv_prepare(size), in, size);
+	m_size = size;
+}
+
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+template <class InCharT>
+inline void SmallString<CharT, inlineCapacity, Allocator>::priv_assign(const InCharT* const in, const InCharT* const end)
+{
+	// the SIMD kernels are only used where there is room for their overrun. otherwise (a short sequence that fits inside), the scalar kernels
+	// convert it exactly into place
+	const std::size_t overrunSize{ priv::kernelOverrun<CharT>() };
+	const std::size_t size{ priv::convertedLength(in, end, CharT{}) };
+	priv::countTranscode<CharT, InCharT>(static_cast<std::size_t>(end - in));
+	CharT* data;
+	CharT* dataEnd;
+	if ((size + overrunSize) <= m_capacity)
+	{
+		data = priv_prepare(0u);
+		dataEnd = priv::transcode(in, end, data);
+	}
+	else if (size <= m_capacity)
+	{
+		data = priv_prepare(0u);
+		dataEnd = priv::scalar::transcode(in, end, data);
+	}
+	else
+	{
+		data = priv_prepare(size + overrunSize);
+		priv::countAllocation((size + overrunSize) * sizeof(CharT));
+		dataEnd = priv::transcode(in, end, data);
+	}
+	m_size = static_cast<std::size_t>(dataEnd - data);
+}
+
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+template <class InCharT>
+inline void SmallString<CharT, inlineCapacity, Allocator>::priv_assignChecked(const InCharT* const in, const InCharT* const end, const ErrorPolicy errorPolicy, std::size_t* const errorOffset)
+{
+	const InCharT* const invalid{ priv::checkedInvalid(in, end, errorPolicy, errorOffset) };
+	if (invalid == end)
+		priv_assign(in, end);
+	else if (errorPolicy == ErrorPolicy::Stop)
+		clear();
+	else
+	{
+		using InAllocator = typename AllocatorTraits::template rebind_alloc<InCharT>;
+		const std::basic_string<InCharT, std::char_traits<InCharT>, InAllocator> repaired{ priv::repairedSequence(in, end, invalid, errorPolicy == ErrorPolicy::Replace, InAllocator(priv_allocator())) };
+		priv_assign(repaired.data(), repaired.data() + repaired.size());
+	}
+}
+
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+inline void SmallString<CharT, inlineCapacity, Allocator>::priv_replace(const std::size_t start, const std::size_t length, const CharT* const units, const std::size_t count, const std::size_t minimumCapacity)
+{
+	const std::size_t size{ m_size - length + count };
+	CharT* const data{ priv_data() };
+	const bool isAliased{ (count != 0u) && (units >= data) && (units < (data + m_size)) }; // inserting (part of) itself
+	if ((size <= m_capacity) && (minimumCapacity <= m_capacity) && !isAliased)
+	{
+		std::char_traits<CharT>::move(data + start + count, data + start + length, m_size - start - length);
+		std::char_traits<CharT>::copy(data + start, units, count);
+		m_size = size;
+		return;
+	}
+
+	// the sequence is rebuilt in new storage, which grows geometrically so that repeated appending is not quadratic
+	std::size_t capacity{ (size > (m_capacity * 2u)) ? size : (m_capacity * 2u) };
+	if (capacity < minimumCapacity)
+		capacity = minimumCapacity;
+	CharT* const heapUnits{ AllocatorTraits::allocate(priv_allocator(), capacity) };
+	std::char_traits<CharT>::copy(heapUnits, data, start);
+	std::char_traits<CharT>::copy(heapUnits + start, units, count);
+	std::char_traits<CharT>::copy(heapUnits + start + count, data + start + length, m_size - start - length);
+	priv_setHeap(heapUnits, capacity);
+	m_size = size;
+}
+
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+inline std::size_t SmallString<CharT, inlineCapacity, Allocator>::priv_codePointOffset(const std::size_t index) const
+{
+	const CharT* const begin{ priv_data() };
+	return static_cast<std::size_t>(priv::findCodePoint(begin, begin + m_size, index) - begin);
+}
+
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+inline std::size_t SmallString<CharT, inlineCapacity, Allocator>::priv_insertOffset(const std::size_t index) const
+{
+	const std::size_t offset{ priv_codePointOffset(index) };
+	if ((offset == m_size) && (index > length())) // only counted when the offset is at the end
+		throw std::out_of_range("yutiyeff: insert offset is past the end of the string");
+	return offset;
+}
+
+} // namespace yutiyeff
+
+namespace std
+{
+
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+struct hash<yutiyeff::SmallString<CharT, inlineCapacity, Allocator>>
+{
+	std::size_t operator()(const yutiyeff::SmallString<CharT, inlineCapacity, Allocator>& string) const { return hash<yutiyeff::StringView<CharT>>{}(string.getView()); }
+};
+
+} // namespace std
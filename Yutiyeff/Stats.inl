@@ -0,0 +1,185 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Yutiyeff (https://github.com/Hapaxia/Yutiyeff)
+//
+// Copyright(c) 2023-2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+
+#pragma once
+
+#include "Yutiyeff.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <type_traits>
+
+namespace yutiyeff
+{
+namespace priv
+{
+
+const std::size_t statsOperationCount{ static_cast<std::size_t>(StatsOperation::Transcoder) + 1u };
+
+struct StatsCounters
+{
+	std::atomic<std::uint64_t> transcodes;
+	std::atomic<std::uint64_t> transcodedBytes;
+	std::atomic<std::uint64_t> allocations;
+	std::atomic<std::uint64_t> allocatedBytes;
+};
+
+// shared by all threads (and counted without ordering)
+inline StatsCounters& statsCounters(const StatsOperation operation)
+{
+	static StatsCounters counters[statsOperationCount]{ };
+	return counters[static_cast<std::size_t>(operation)];
+}
+
+// the operation that this thread is doing. conversions that are not inside one of the other operations are constructions
+inline StatsOperation& currentStatsOperation()
+{
+	static thread_local StatsOperation operation{ StatsOperation::Construction };
+	return operation;
+}
+
+// counts the conversions (and allocations) inside it as a given operation (unless it is already inside another one)
+class StatsScope
+{
+public:
+	explicit StatsScope(StatsOperation operation);
+	~StatsScope();
+	StatsScope(const StatsScope&) = delete;
+	StatsScope& operator=(const StatsScope&) = delete;
+
+#ifdef YUTIYEFF_STATS
+private:
+	const bool m_isOutermost;
+#endif // YUTIYEFF_STATS
+};
+
+#ifdef YUTIYEFF_STATS
+inline StatsScope::StatsScope(const StatsOperation operation)
+	: m_isOutermost{ currentStatsOperation() == StatsOperation::Construction }
+{
+	if (m_isOutermost)
+		currentStatsOperation() = operation;
+}
+
+inline StatsScope::~StatsScope()
+{
+	if (m_isOutermost)
+		currentStatsOperation() = StatsOperation::Construction;
+}
+#else // YUTIYEFF_STATS
+inline StatsScope::StatsScope(StatsOperation)
+{
+}
+
+inline StatsScope::~StatsScope()
+{
+}
+#endif // YUTIYEFF_STATS
+
+// a conversion of "size" code units of InT into OutT (which is only a copy, and is not counted, if they are the same)
+template <class OutT, class InT>
+inline void countTranscode(const std::size_t size)
+{
+#ifdef YUTIYEFF_STATS
+	if (std::is_same<OutT, InT>::value)
+		return;
+	StatsCounters& counters{ statsCounters(currentStatsOperation()) };
+	counters.transcodes.fetch_add(1u, std::memory_order_relaxed);
+	counters.transcodedBytes.fetch_add(size * sizeof(InT), std::memory_order_relaxed);
+#else // YUTIYEFF_STATS
+	static_cast<void>(size);
+#endif // YUTIYEFF_STATS
+}
+
+inline void countAllocation(const std::size_t size)
+{
+#ifdef YUTIYEFF_STATS
+	StatsCounters& counters{ statsCounters(currentStatsOperation()) };
+	counters.allocations.fetch_add(1u, std::memory_order_relaxed);
+	counters.allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+#else // YUTIYEFF_STATS
+	static_cast<void>(size);
+#endif // YUTIYEFF_STATS
+}
+
+// a sequence that was created for a conversion (which only allocated if it is too long to be kept inside the string)
+template <class CharT, class Traits, class Allocator>
+inline void countAllocation(const std::basic_string<CharT, Traits, Allocator>& sequence)
+{
+#ifdef YUTIYEFF_STATS
+	if (sequence.capacity() > std::basic_string<CharT, Traits, Allocator>(sequence.get_allocator()).capacity())
+		countAllocation(sequence.capacity() * sizeof(CharT));
+#else // YUTIYEFF_STATS
+	static_cast<void>(sequence);
+#endif // YUTIYEFF_STATS
+}
+
+} // namespace priv
+
+inline Stats getStats(const StatsOperation operation)
+{
+	const priv::StatsCounters& counters{ priv::statsCounters(operation) };
+	Stats stats;
+	stats.transcodes = counters.transcodes.load(std::memory_order_relaxed);
+	stats.transcodedBytes = counters.transcodedBytes.load(std::memory_order_relaxed);
+	stats.allocations = counters.allocations.load(std::memory_order_relaxed);
+	stats.allocatedBytes = counters.allocatedBytes.load(std::memory_order_relaxed);
+	return stats;
+}
+
+inline Stats getStats()
+{
+	Stats total;
+	for (std::size_t operation{ 0u }; operation < priv::statsOperationCount; ++operation)
+	{
+		const Stats stats{ getStats(static_cast<StatsOperation>(operation)) };
+		total.transcodes += stats.transcodes;
+		total.transcodedBytes += stats.transcodedBytes;
+		total.allocations += stats.allocations;
+		total.allocatedBytes += stats.allocatedBytes;
+	}
+	return total;
+}
+
+inline void resetStats()
+{
+	for (std::size_t operation{ 0u }; operation < priv::statsOperationCount; ++operation)
+	{
+		priv::StatsCounters& counters{ priv::statsCounters(static_cast<StatsOperation>(operation)) };
+		counters.transcodes.store(0u, std::memory_order_relaxed);
+		counters.transcodedBytes.store(0u, std::memory_order_relaxed);
+		counters.allocations.store(0u, std::memory_order_relaxed);
+		counters.allocatedBytes.store(0u, std::memory_order_relaxed);
+	}
+}
+
+} // namespace yutiyeff
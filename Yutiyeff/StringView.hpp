@@ -0,0 +1,98 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Yutiyeff (https://github.com/Hapaxia/Yutiyeff)
+//
+// Copyright(c) 2023-2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <string>
+
+#include "CodePointIterator.hpp"
+
+namespace yutiyeff
+{
+
+// a read-only view of a sequence (UTF-8, UTF-16 or UTF-32) that is stored elsewhere. nothing is copied so the sequence must outlive the view.
+// offsets and lengths are in code points (as with the string types); the sequence itself is measured in code units (its "data")
+template <class CharT>
+class StringView
+{
+public:
+	using const_iterator = CodePointIterator<CharT>;
+	using iterator = const_iterator;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+	using reverse_iterator = const_reverse_iterator;
+
+	StringView() = default;
+	StringView(const CharT* data, std::size_t dataSize);
+	StringView(const CharT* cString); // null-terminated (and not null)
+	StringView(const std::basic_string<CharT>& sequence);
+
+	std::string getString() const; // get a standard std::string representing the UTF-8 formatted version of the view
+	std::string getNonUnicodeString() const; // get a standard std::string of only the codes in the 0-127 range
+	std::size_t length() const;
+
+	char32_t operator[](std::size_t index) const; // U+FFFD if the sequence there is invalid (as it would be in a string) and 0 past the end
+
+	std::size_t find(const StringView& view, std::size_t offset = 0u) const;
+	StringView substr(std::size_t length, std::size_t offset = 0u) const;
+
+	// views are not checked when they are created (the string types check the sequence when they are created from a view)
+	std::size_t findInvalid() const; // the offset (in code units) of the first invalid sequence or npos if the view is valid
+	bool isValid() const { return findInvalid() == std::basic_string<CharT>::npos; }
+
+	bool empty() const { return m_dataSize == 0u; }
+	std::size_t size() const { return length(); }
+
+	const CharT* getData() const { return m_data; }
+	std::size_t getDataSize() const { return m_dataSize; } // in code units
+	std::basic_string<CharT> getSequence() const { return std::basic_string<CharT>(m_data, m_dataSize); } // copies the sequence
+
+	const_iterator begin() const;
+	const_iterator end() const;
+	const_iterator cbegin() const { return begin(); }
+	const_iterator cend() const { return end(); }
+	const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+	const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+	const_reverse_iterator crbegin() const { return rbegin(); }
+	const_reverse_iterator crend() const { return rend(); }
+
+private:
+	const CharT* m_data{ nullptr };
+	std::size_t m_dataSize{ 0u };
+
+	const CharT* priv_dataEnd() const { return m_data + m_dataSize; }
+};
+
+using Utf8StringView = StringView<char>;
+using Utf16StringView = StringView<char16_t>;
+using Utf32StringView = StringView<char32_t>;
+
+} // namespace yutiyeff
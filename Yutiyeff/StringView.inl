@@ -0,0 +1,152 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Yutiyeff (https://github.com/Hapaxia/Yutiyeff)
+//
+// Copyright(c) 2023-2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include "StringView.hpp"
+#include "Kernels.inl"
+#include "Simd.inl"
+
+#include <functional>
+
+namespace yutiyeff
+{
+
+template <class CharT>
+inline StringView<CharT>::StringView(const CharT* const data, const std::size_t dataSize)
+	: m_data{ data }
+	, m_dataSize{ dataSize }
+{
+}
+
+template <class CharT>
+inline StringView<CharT>::StringView(const CharT* const cString)
+	: m_data{ cString }
+	, m_dataSize{ std::char_traits<CharT>::length(cString) }
+{
+}
+
+template <class CharT>
+inline StringView<CharT>::StringView(const std::basic_string<CharT>& sequence)
+	: m_data{ sequence.data() }
+	, m_dataSize{ sequence.size() }
+{
+}
+
+template <class CharT>
+inline std::string StringView<CharT>::getString() const
+{
+	const priv::StatsScope statsScope{ StatsOperation::Output };
+	return priv::utf8String(m_data, priv_dataEnd());
+}
+
+template <class CharT>
+inline std::string StringView<CharT>::getNonUnicodeString() const
+{
+	const priv::StatsScope statsScope{ StatsOperation::Output };
+	return priv::nonUnicodeString(m_data, priv_dataEnd());
+}
+
+template <class CharT>
+inline std::size_t StringView<CharT>::length() const
+{
+	return priv::codePointCount(m_data, priv_dataEnd());
+}
+
+template <class CharT>
+inline char32_t StringView<CharT>::operator[](const std::size_t index) const
+{
+	const CharT* const current{ priv::findCodePoint(m_data, priv_dataEnd(), index) };
+	return (current != priv_dataEnd()) ? priv::codePointAt(current, priv_dataEnd()) : 0u;
+}
+
+template <class CharT>
+inline std::size_t StringView<CharT>::find(const StringView& view, const std::size_t offset) const
+{
+	if (view.empty())
+		return (offset <= length()) ? offset : std::basic_string<CharT>::npos;
+
+	const CharT* const begin{ priv::findCodePoint(m_data, priv_dataEnd(), offset) };
+	const CharT* const match{ priv::findCodePoints(begin, priv_dataEnd(), view.m_data, view.m_dataSize) };
+	return (match != priv_dataEnd()) ? (offset + priv::codePointCount(begin, match)) : std::basic_string<CharT>::npos;
+}
+
+template <class CharT>
+inline StringView<CharT> StringView<CharT>::substr(const std::size_t length, const std::size_t offset) const
+{
+	const CharT* const begin{ priv::findCodePoint(m_data, priv_dataEnd(), offset) };
+	const CharT* const end{ priv::findCodePoint(begin, priv_dataEnd(), length) };
+	return StringView(begin, static_cast<std::size_t>(end - begin));
+}
+
+template <class CharT>
+inline std::size_t StringView<CharT>::findInvalid() const
+{
+	const CharT* const invalid{ priv::findInvalid(m_data, priv_dataEnd()) };
+	return (invalid != priv_dataEnd()) ? static_cast<std::size_t>(invalid - m_data) : std::basic_string<CharT>::npos;
+}
+
+template <class CharT>
+inline typename StringView<CharT>::const_iterator StringView<CharT>::begin() const
+{
+	const CharT* const first{ priv::findCodePoint(m_data, priv_dataEnd(), 0u) };
+	return const_iterator(first, first, priv_dataEnd());
+}
+
+template <class CharT>
+inline typename StringView<CharT>::const_iterator StringView<CharT>::end() const
+{
+	return const_iterator(priv_dataEnd(), priv::findCodePoint(m_data, priv_dataEnd(), 0u), priv_dataEnd());
+}
+
+template <class CharT>
+inline bool operator==(const StringView<CharT>& lhs, const StringView<CharT>& rhs)
+{
+	return priv::equalCodePoints(lhs.getData(), lhs.getData() + lhs.getDataSize(), rhs.getData(), rhs.getData() + rhs.getDataSize());
+}
+
+template <class CharT>
+inline bool operator!=(const StringView<CharT>& lhs, const StringView<CharT>& rhs)
+{
+	return !(lhs == rhs);
+}
+
+} // namespace yutiyeff
+
+namespace std
+{
+
+template <class CharT>
+struct hash<yutiyeff::StringView<CharT>>
+{
+	std::size_t operator()(const yutiyeff::StringView<CharT>& view) const { return yutiyeff::priv::hashCodePoints(view.getData(), view.getData() + view.getDataSize()); }
+};
+
+} // namespace std
@@ -0,0 +1,68 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Yutiyeff (https://github.com/Hapaxia/Yutiyeff)
+//
+// Copyright(c) 2023-2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include <cstddef>
+
+namespace yutiyeff
+{
+
+// converts a stream (e.g. a file or a socket) from one encoding to another in chunks of any size.
+// a sequence that is split by the end of a chunk is kept back and completed by the next chunk so only a few code units are ever held.
+// valid input gives the same result as converting it all at once; invalid sequences are dropped (as they are when converting a string)
+template <class OutT, class InT>
+class Transcoder
+{
+public:
+	// converts a chunk into "out" (which must have room for "getMaxOutputSize" of the chunk's size) and returns the end of what was written
+	OutT* convert(const InT* in, const InT* end, OutT* out);
+
+	bool hasPendingSequence() const { return m_pendingSize != 0u; } // true if the last chunk ended part way through a sequence (which would be dropped if the stream ended there)
+	void reset() { m_pendingSize = 0u; } // starts a new stream (dropping any sequence kept back)
+
+	static std::size_t getMaxOutputSize(std::size_t chunkSize); // in code units
+
+private:
+	static constexpr std::size_t maxSequenceLength{ 4u / sizeof(InT) }; // 4 for UTF-8, 2 for UTF-16 and 1 for UTF-32
+	static constexpr std::size_t maxExpansion{ (sizeof(OutT) >= sizeof(InT)) ? 1u : ((sizeof(InT) == 2u) ? 3u : (sizeof(InT) / sizeof(OutT))) }; // output code units from one input code unit
+
+	InT m_pending[maxSequenceLength];
+	std::size_t m_pendingSize{ 0u };
+};
+
+using Utf8FromUtf16Transcoder = Transcoder<char, char16_t>;
+using Utf8FromUtf32Transcoder = Transcoder<char, char32_t>;
+using Utf16FromUtf8Transcoder = Transcoder<char16_t, char>;
+using Utf16FromUtf32Transcoder = Transcoder<char16_t, char32_t>;
+using Utf32FromUtf8Transcoder = Transcoder<char32_t, char>;
+using Utf32FromUtf16Transcoder = Transcoder<char32_t, char16_t>;
+
+} // namespace yutiyeff
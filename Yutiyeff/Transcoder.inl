@@ -0,0 +1,80 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Yutiyeff (https://github.com/Hapaxia/Yutiyeff)
+//
+// Copyright(c) 2023-2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include "Transcoder.hpp"
+#include "Kernels.inl"
+#include "Simd.inl"
+
+namespace yutiyeff
+{
+
+template <class OutT, class InT>
+inline OutT* Transcoder<OutT, InT>::convert(const InT* in, const InT* const end, OutT* out)
+{
+	const priv::StatsScope statsScope{ StatsOperation::Transcoder };
+	priv::countTranscode<OutT, InT>(static_cast<std::size_t>(end - in));
+	if (m_pendingSize != 0u)
+	{
+		// complete the sequence that was kept back from the previous chunk
+		const std::size_t pendingLength{ priv::sequenceLength(m_pending[0]) };
+		while ((m_pendingSize < pendingLength) && (in != end))
+			m_pending[m_pendingSize++] = *in++;
+		if (m_pendingSize < pendingLength)
+			return out;
+		out = priv::transcode(m_pending, m_pending + m_pendingSize, out);
+		m_pendingSize = 0u;
+	}
+
+	// keep back the last sequence if it is not complete (it can only start in the last few code units)
+	const InT* split{ end };
+	for (const InT* current{ end }; (current != in) && (static_cast<std::size_t>(end - current) < maxSequenceLength);)
+	{
+		if (priv::isCodePointStart(*--current))
+		{
+			if (priv::sequenceLength(*current) > static_cast<std::size_t>(end - current))
+				split = current;
+			break;
+		}
+	}
+	out = priv::transcode(in, split, out);
+	for (; split != end; ++split)
+		m_pending[m_pendingSize++] = *split;
+	return out;
+}
+
+template <class OutT, class InT>
+inline std::size_t Transcoder<OutT, InT>::getMaxOutputSize(const std::size_t chunkSize)
+{
+	return (chunkSize + maxSequenceLength - 1u) * maxExpansion;
+}
+
+} // namespace yutiyeff
@@ -29,21 +29,122 @@
 
 #pragma once
 
+#include <cstdint>
+#include <stdexcept>
 #include <string>
+#include <utility>
 
 #include <iostream>
 
+#include "CodePointIterator.hpp"
+#include "StringView.hpp"
+#include "Transcoder.hpp"
+#ifdef YUTIYEFF_INDEX
+#include "CodePointIndex.hpp"
+#endif // YUTIYEFF_INDEX
+
 #if __cplusplus >= 202002L
 #define YUTIYEFF_CPP20
 #endif // 202002L
 
+#if (__cplusplus >= 201703L) || defined(YUTIYEFF_CPP20)
+#define YUTIYEFF_CPP17
+#endif // 201703L
+
+// with C++20, the scalar conversion kernels (and the code point functions that they use) are constexpr so they can encode at compile time (see FixedString)
+#ifdef YUTIYEFF_CPP20
+#define YUTIYEFF_CONSTEXPR constexpr
+#else // YUTIYEFF_CPP20
+#define YUTIYEFF_CONSTEXPR
+#endif // YUTIYEFF_CPP20
+
+// without YUTIYEFF_NO_VIRTUAL, the functions of the string types are virtual (and overridden by each type).
+// with it, they are not virtual and calls through the String base are forwarded to the derived type at compile time
+#ifdef YUTIYEFF_NO_VIRTUAL
+#define YUTIYEFF_OVERRIDE
+#else // YUTIYEFF_NO_VIRTUAL
+#define YUTIYEFF_OVERRIDE override final
+#endif // YUTIYEFF_NO_VIRTUAL
+
+#if !defined(YUTIYEFF_NO_SIMD) && (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+#define YUTIYEFF_SIMD_X86
+#endif // YUTIYEFF_NO_SIMD
+
 namespace yutiyeff
 {
 
+// conversion kernels. by default, the fastest one that the CPU supports is chosen the first time it is needed
+enum class Kernel
+{
+	Automatic,
+	Scalar,
+	Sse42,
+	Avx2,
+	Avx512,
+};
+
+inline bool isKernelSupported(Kernel kernel);
+inline bool setKernel(Kernel kernel); // forces a specific kernel (Automatic returns to the CPU's choice). returns false, without changing anything, if the kernel is not supported
+inline Kernel getKernel(); // the kernel currently being used (never Automatic)
+
+// what to do with invalid sequences (overlong forms, surrogates, code points above 0x10FFFF, stray or missing continuation bytes and unpaired surrogates)
+// when a string is created from a sequence. strings are always valid so their own operations don't need to check anything
+enum class ErrorPolicy
+{
+	Replace, // each invalid part is replaced by U+FFFD (the replacement character)
+	Skip, // invalid parts are removed
+	Stop, // the string is left empty (the error offset says where the first invalid part is)
+	Throw, // InvalidSequence is thrown (with the offset of the first invalid part)
+	AssumeValid, // nothing is checked. only for sequences that are already known to be valid
+};
+
+// thrown (with ErrorPolicy::Throw) when a sequence has an invalid part
+class InvalidSequence : public std::invalid_argument
+{
+public:
+	explicit InvalidSequence(std::size_t offset);
+	std::size_t getOffset() const { return m_offset; } // in code units of the sequence (the same as the error offset)
+
+private:
+	std::size_t m_offset;
+};
+
+// counters of the conversions (between encodings) that Yutiyeff does and the sequences that it allocates for them, kept for each kind of operation.
+// they are only counted when YUTIYEFF_STATS is defined (otherwise they are always zero and counting costs nothing)
+enum class StatsOperation
+{
+	Construction, // creating a string from another encoding, including arguments that are converted implicitly (e.g. a Utf16String passed to Utf8String::find)
+	Output, // getString (and operator std::string) and getNonUnicodeString
+	Swap, // swapping strings of different types
+	Cache, // cached strings converting an encoding when it is read
+	Rope, // ropes converting their text
+	Column, // columns converting their sequences
+	Parallel, // convertInParallel
+	Transcoder, // transcoders converting chunks
+};
+
+struct Stats
+{
+	std::uint64_t transcodes{ 0u }; // conversions of a sequence from one encoding to another
+	std::uint64_t transcodedBytes{ 0u }; // the size of the sequences that were converted
+	std::uint64_t allocations{ 0u }; // sequences allocated for the conversions (not those that are small enough to be kept inside a string)
+	std::uint64_t allocatedBytes{ 0u };
+};
+
+inline Stats getStats(StatsOperation operation);
+inline Stats getStats(); // all operations together
+inline void resetStats();
+
 template <class T, class CharT>
 class String
 {
 public:
+	using const_iterator = CodePointIterator<CharT>;
+	using iterator = const_iterator; // code points can only be changed using "set"
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+	using reverse_iterator = const_reverse_iterator;
+
+#ifndef YUTIYEFF_NO_VIRTUAL
 	virtual operator std::string() const = 0;
 	virtual std::string getString() const = 0; // get a standard std::string representing the UTF-8 formatted version of the string
 	virtual std::string getNonUnicodeString() const = 0; // get a standard std::string of only the codes in the 0-127 range
@@ -53,7 +154,9 @@ public:
 	virtual void clear() = 0;
 
 	virtual T& operator=(const T& tString) = 0;
-	virtual T operator+(const T& tString) const = 0;
+	virtual T& operator=(T&& tString) noexcept = 0;
+	virtual T operator+(const T& tString) const & = 0;
+	virtual T operator+(const T& tString) && = 0; // appends to (and then takes the sequence of) a temporary string
 	virtual T& operator+=(const T& tString) = 0;
 
 	virtual std::size_t find(const T& tString, std::size_t offset = 0u) const = 0;
@@ -64,15 +167,65 @@ public:
 	virtual void set(std::size_t offset, char32_t char32) = 0; // sets a single u32-character/code-point in the string. offset is the code point index. this replaces a code-point.
 
 	virtual void reserve(std::size_t dataPointsCap) = 0;
+#else // YUTIYEFF_NO_VIRTUAL
+	operator std::string() const { return priv_derived().operator std::string(); }
+	std::string getString() const { return priv_derived().getString(); }
+	std::string getNonUnicodeString() const { return priv_derived().getNonUnicodeString(); }
+	size_t length() const { return priv_derived().length(); }
+
+	char32_t operator[](std::size_t index) const { return priv_derived()[index]; }
+	void clear() { priv_derived().clear(); }
+
+	T& operator=(const T& tString) { return priv_derived() = tString; }
+	T& operator=(T&& tString) noexcept { return priv_derived() = std::move(tString); }
+	T operator+(const T& tString) const & { return priv_derived() + tString; }
+	T operator+(const T& tString) && { return std::move(priv_derived()) + tString; }
+	T& operator+=(const T& tString) { return priv_derived() += tString; }
+
+	std::size_t find(const T& tString, std::size_t offset = 0u) const { return priv_derived().find(tString, offset); }
+	T substr(std::size_t length, std::size_t offset = 0u) const { return priv_derived().substr(length, offset); }
+	void insert(std::size_t offset, const T& tString) { priv_derived().insert(offset, tString); }
+	void insert(std::size_t offset, char32_t char32) { priv_derived().insert(offset, char32); }
+	void erase(std::size_t startPos, std::size_t length = 0u) { priv_derived().erase(startPos, length); }
+	void set(std::size_t offset, char32_t char32) { priv_derived().set(offset, char32); }
+
+	void reserve(std::size_t dataPointsCap) { priv_derived().reserve(dataPointsCap); }
+#endif // YUTIYEFF_NO_VIRTUAL
 
 
 
 	bool empty() const { return m_sequence.empty(); }
 	std::size_t size() const { return length(); }
 
-	void swap(T& other) { std::swap(m_sequence, other.m_sequence); }
+	void swap(T& other);
+
+	// converts a string (of any type) into this one, keeping this string's capacity so that it only allocates if it must grow
+	template <class FromT, class FromCharT>
+	void assign(const String<FromT, FromCharT>& string);
+
+	StringView<CharT> getView() const { return StringView<CharT>(m_sequence); } // the view is invalidated by any change to the string
+	operator StringView<CharT>() const { return getView(); }
+
+	const std::basic_string<CharT>& getSequence() const & { return m_sequence; }
+	std::basic_string<CharT> getSequence() && { priv_resetIndex(); return std::move(m_sequence); } // takes the sequence from a temporary (or moved) string without copying
+
+	// create a string from a sequence in any encoding, handling invalid sequences using the error policy. if "errorOffset" is given, it is set to
+	// the offset (in code units of the sequence) of the first invalid sequence, or npos if there is none. a valid sequence in this string's encoding is moved in, not copied
+	static T fromSequence(std::basic_string<CharT>&& sequence, ErrorPolicy errorPolicy = ErrorPolicy::Replace, std::size_t* errorOffset = nullptr);
+	template <class InCharT>
+	static T fromSequence(const std::basic_string<InCharT>& sequence, ErrorPolicy errorPolicy = ErrorPolicy::Replace, std::size_t* errorOffset = nullptr);
+	template <class InCharT>
+	static T fromSequence(const StringView<InCharT>& sequence, ErrorPolicy errorPolicy = ErrorPolicy::Replace, std::size_t* errorOffset = nullptr);
 
-	std::basic_string<CharT> getSequence() const { return m_sequence; };
+	// iterate code points (decoding them in place). any change to the string invalidates its iterators
+	const_iterator begin() const;
+	const_iterator end() const;
+	const_iterator cbegin() const { return begin(); }
+	const_iterator cend() const { return end(); }
+	const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+	const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+	const_reverse_iterator crbegin() const { return rbegin(); }
+	const_reverse_iterator crend() const { return rend(); }
 
 protected:
 	String() = default;
@@ -80,11 +233,27 @@ protected:
 	String(String&&) = default;
 
 	std::basic_string<CharT> m_sequence;
+#ifdef YUTIYEFF_INDEX
+	mutable priv::CodePointIndex<CharT> m_index;
+#endif // YUTIYEFF_INDEX
 
+#ifdef YUTIYEFF_NO_VIRTUAL
+	T& priv_derived() { return static_cast<T&>(*this); }
+	const T& priv_derived() const { return static_cast<const T&>(*this); }
+#endif // YUTIYEFF_NO_VIRTUAL
+
+	std::size_t priv_codePointOffset(std::size_t index) const; // offset (in code units) of a code point in the sequence. returns the size of the sequence if the index is past the end
+	std::size_t priv_insertOffset(std::size_t index) const; // the same for inserting, which can be at the end. throws std::out_of_range (as std::basic_string::insert does) if the index is past the end
+	void priv_resetIndex(); // must be called whenever the sequence is changed (unless priv_shiftIndex is used instead)
+	void priv_shiftIndex(std::size_t index, std::ptrdiff_t difference); // code units were added to (or removed from) a code point without changing the number of code points
+
+	// conversions between the sequences of strings (which are always valid)
 	static std::basic_string<char> priv_utf8FromUtf32(const std::basic_string<char32_t>& utf32String);
 	static std::basic_string<char16_t> priv_utf16FromUtf32(const std::basic_string<char32_t>& utf32String);
 	static std::basic_string<char32_t> priv_utf32FromUtf8(const std::basic_string<char>& utf8String);
 	static std::basic_string<char32_t> priv_utf32FromUtf16(const std::basic_string<char16_t>& utf16String);
+	static std::basic_string<char> priv_utf8FromUtf16(const std::basic_string<char16_t>& utf16String);
+	static std::basic_string<char16_t> priv_utf16FromUtf8(const std::basic_string<char>& utf8String);
 };
 
 
@@ -114,35 +283,42 @@ public:
 	Utf8String(const char32_t* cU32String);
 	Utf8String(const char32_t cU32);
 	Utf8String(const std::basic_string<char>& u8String);
+	Utf8String(std::basic_string<char>&& u8String);
 #ifdef YUTIYEFF_CPP20
 	Utf8String(const std::basic_string<char8_t>& u8String);
 #endif // YUTIYEFF_CPP20
 	Utf8String(const std::basic_string<char16_t>& u16String);
 	Utf8String(const std::basic_string<char32_t>& u32String);
 	Utf8String(const Utf8String& utf8String);
+	Utf8String(Utf8String&& utf8String) noexcept;
 	Utf8String(const Utf16String& utf16String);
 	Utf8String(const Utf32String& utf32String);
-
-	Utf8String& operator=(const Utf8String& utf8String) override final;
-	Utf8String operator+(const Utf8String& utf8String) const override final;
-	Utf8String& operator+=(const Utf8String& utf8String) override final;
-
-	std::size_t find(const Utf8String& utf8String, std::size_t offset = 0u) const override final;
-	Utf8String substr(std::size_t length, std::size_t offset = 0u) const override final;
-	void insert(std::size_t offset, const Utf8String& utf8String) override final;
-	void insert(std::size_t offset, char32_t char32) override final;
-	void erase(std::size_t startPos, std::size_t length = 0u) override final;
-	void set(std::size_t index, char32_t char32) override final;
-
-	void reserve(std::size_t dataPointsCap) override final;
-
-	operator std::string() const override final;
-	std::string getString() const override final;
-	std::string getNonUnicodeString() const override final;
-	std::size_t length() const override final;
-
-	char32_t operator[](std::size_t index) const override final;
-	void clear() override final;
+	Utf8String(const Utf8StringView& utf8StringView);
+	Utf8String(const Utf16StringView& utf16StringView);
+	Utf8String(const Utf32StringView& utf32StringView);
+
+	Utf8String& operator=(const Utf8String& utf8String) YUTIYEFF_OVERRIDE;
+	Utf8String& operator=(Utf8String&& utf8String) noexcept YUTIYEFF_OVERRIDE;
+	Utf8String operator+(const Utf8String& utf8String) const & YUTIYEFF_OVERRIDE;
+	Utf8String operator+(const Utf8String& utf8String) && YUTIYEFF_OVERRIDE;
+	Utf8String& operator+=(const Utf8String& utf8String) YUTIYEFF_OVERRIDE;
+
+	std::size_t find(const Utf8String& utf8String, std::size_t offset = 0u) const YUTIYEFF_OVERRIDE;
+	Utf8String substr(std::size_t length, std::size_t offset = 0u) const YUTIYEFF_OVERRIDE;
+	void insert(std::size_t offset, const Utf8String& utf8String) YUTIYEFF_OVERRIDE;
+	void insert(std::size_t offset, char32_t char32) YUTIYEFF_OVERRIDE;
+	void erase(std::size_t startPos, std::size_t length = 0u) YUTIYEFF_OVERRIDE;
+	void set(std::size_t index, char32_t char32) YUTIYEFF_OVERRIDE;
+
+	void reserve(std::size_t dataPointsCap) YUTIYEFF_OVERRIDE;
+
+	operator std::string() const YUTIYEFF_OVERRIDE;
+	std::string getString() const YUTIYEFF_OVERRIDE;
+	std::string getNonUnicodeString() const YUTIYEFF_OVERRIDE;
+	std::size_t length() const YUTIYEFF_OVERRIDE;
+
+	char32_t operator[](std::size_t index) const YUTIYEFF_OVERRIDE;
+	void clear() YUTIYEFF_OVERRIDE;
 };
 
 class Utf16String : public String<Utf16String, char16_t>
@@ -165,31 +341,38 @@ public:
 	Utf16String(const std::basic_string<char8_t>& u8String);
 #endif // YUTIYEFF_CPP20
 	Utf16String(const std::basic_string<char16_t>& u16String);
+	Utf16String(std::basic_string<char16_t>&& u16String);
 	Utf16String(const std::basic_string<char32_t>& u32String);
 	Utf16String(const Utf8String& utf8String);
 	Utf16String(const Utf16String& utf16String);
+	Utf16String(Utf16String&& utf16String) noexcept;
 	Utf16String(const Utf32String& utf32String);
-
-	Utf16String& operator=(const Utf16String& utf16String) override final;
-	Utf16String operator+(const Utf16String& utf16String) const override final;
-	Utf16String& operator+=(const Utf16String& utf16String) override final;
-
-	std::size_t find(const Utf16String& utf16String, std::size_t offset) const override final;
-	Utf16String substr(std::size_t length, std::size_t offset = 0u) const override final;
-	void insert(std::size_t offset, const Utf16String& utf16String) override final;
-	void insert(std::size_t offset, char32_t char32) override final;
-	void erase(std::size_t startPos, std::size_t length = 0u) override final;
-	void set(std::size_t index, char32_t char32) override final;
-
-	operator std::string() const override final;
-	std::string getString() const override final;
-	std::string getNonUnicodeString() const override final;
-	std::size_t length() const override final;
-
-	void reserve(std::size_t dataPointsCap) override final;
-
-	char32_t operator[](std::size_t index) const override final;
-	void clear() override final;
+	Utf16String(const Utf8StringView& utf8StringView);
+	Utf16String(const Utf16StringView& utf16StringView);
+	Utf16String(const Utf32StringView& utf32StringView);
+
+	Utf16String& operator=(const Utf16String& utf16String) YUTIYEFF_OVERRIDE;
+	Utf16String& operator=(Utf16String&& utf16String) noexcept YUTIYEFF_OVERRIDE;
+	Utf16String operator+(const Utf16String& utf16String) const & YUTIYEFF_OVERRIDE;
+	Utf16String operator+(const Utf16String& utf16String) && YUTIYEFF_OVERRIDE;
+	Utf16String& operator+=(const Utf16String& utf16String) YUTIYEFF_OVERRIDE;
+
+	std::size_t find(const Utf16String& utf16String, std::size_t offset) const YUTIYEFF_OVERRIDE;
+	Utf16String substr(std::size_t length, std::size_t offset = 0u) const YUTIYEFF_OVERRIDE;
+	void insert(std::size_t offset, const Utf16String& utf16String) YUTIYEFF_OVERRIDE;
+	void insert(std::size_t offset, char32_t char32) YUTIYEFF_OVERRIDE;
+	void erase(std::size_t startPos, std::size_t length = 0u) YUTIYEFF_OVERRIDE;
+	void set(std::size_t index, char32_t char32) YUTIYEFF_OVERRIDE;
+
+	operator std::string() const YUTIYEFF_OVERRIDE;
+	std::string getString() const YUTIYEFF_OVERRIDE;
+	std::string getNonUnicodeString() const YUTIYEFF_OVERRIDE;
+	std::size_t length() const YUTIYEFF_OVERRIDE;
+
+	void reserve(std::size_t dataPointsCap) YUTIYEFF_OVERRIDE;
+
+	char32_t operator[](std::size_t index) const YUTIYEFF_OVERRIDE;
+	void clear() YUTIYEFF_OVERRIDE;
 };
 
 class Utf32String final : public String<Utf32String, char32_t>
@@ -213,34 +396,56 @@ public:
 #endif // YUTIYEFF_CPP20
 	Utf32String(const std::basic_string<char16_t>& u16String);
 	Utf32String(const std::basic_string<char32_t>& u32String);
+	Utf32String(std::basic_string<char32_t>&& u32String);
 	Utf32String(const Utf8String& utf8String);
 	Utf32String(const Utf16String& utf16String);
 	Utf32String(const Utf32String& utf32String);
-
-	Utf32String& operator=(const Utf32String& utf32String) override final;
-	Utf32String operator+(const Utf32String& utf32String) const override final;
-	Utf32String& operator+=(const Utf32String& utf32String) override final;
-
-	std::size_t find(const Utf32String& utf32String, std::size_t offset) const override final;
-	Utf32String substr(std::size_t length, std::size_t offset = 0u) const override final;
-	void insert(std::size_t offset, const Utf32String& utf32String) override final;
-	void insert(std::size_t offset, char32_t char32) override final;
-	void erase(std::size_t startPos, std::size_t length = 0u) override final;
-	void set(std::size_t index, char32_t char32) override final;
-
-	operator std::string() const override final;
-	std::string getString() const override final;
-	std::string getNonUnicodeString() const override final;
-	std::size_t length() const override final;
-
-	void reserve(std::size_t dataPointsCap) override final;
-
-	char32_t operator[](std::size_t index) const override final;
-	void clear() override final;
+	Utf32String(Utf32String&& utf32String) noexcept;
+	Utf32String(const Utf8StringView& utf8StringView);
+	Utf32String(const Utf16StringView& utf16StringView);
+	Utf32String(const Utf32StringView& utf32StringView);
+
+	Utf32String& operator=(const Utf32String& utf32String) YUTIYEFF_OVERRIDE;
+	Utf32String& operator=(Utf32String&& utf32String) noexcept YUTIYEFF_OVERRIDE;
+	Utf32String operator+(const Utf32String& utf32String) const & YUTIYEFF_OVERRIDE;
+	Utf32String operator+(const Utf32String& utf32String) && YUTIYEFF_OVERRIDE;
+	Utf32String& operator+=(const Utf32String& utf32String) YUTIYEFF_OVERRIDE;
+
+	std::size_t find(const Utf32String& utf32String, std::size_t offset) const YUTIYEFF_OVERRIDE;
+	Utf32String substr(std::size_t length, std::size_t offset = 0u) const YUTIYEFF_OVERRIDE;
+	void insert(std::size_t offset, const Utf32String& utf32String) YUTIYEFF_OVERRIDE;
+	void insert(std::size_t offset, char32_t char32) YUTIYEFF_OVERRIDE;
+	void erase(std::size_t startPos, std::size_t length = 0u) YUTIYEFF_OVERRIDE;
+	void set(std::size_t index, char32_t char32) YUTIYEFF_OVERRIDE;
+
+	operator std::string() const YUTIYEFF_OVERRIDE;
+	std::string getString() const YUTIYEFF_OVERRIDE;
+	std::string getNonUnicodeString() const YUTIYEFF_OVERRIDE;
+	std::size_t length() const YUTIYEFF_OVERRIDE;
+
+	void reserve(std::size_t dataPointsCap) YUTIYEFF_OVERRIDE;
+
+	char32_t operator[](std::size_t index) const YUTIYEFF_OVERRIDE;
+	void clear() YUTIYEFF_OVERRIDE;
 };
 
 } // namespace yutiyeff
 
+#include "SmallString.hpp" // after the string types, which it can be created from
+#include "Column.hpp"
+#include "CachedString.hpp"
+#include "Rope.hpp"
+#include "Conversion.hpp"
+#ifdef YUTIYEFF_CPP20
+#include "FixedString.hpp"
+#endif // YUTIYEFF_CPP20
+#ifndef YUTIYEFF_NO_THREADS
+#include "Parallel.hpp"
+#endif // YUTIYEFF_NO_THREADS
+#ifndef YUTIYEFF_NO_MAPPED_FILE
+#include "MappedFile.hpp" // after ErrorPolicy, which its string getters take
+#endif // YUTIYEFF_NO_MAPPED_FILE
+
 #ifndef YUTIYEFF_NO_NAMESPACE_SHORTCUT
 namespace yy = yutiyeff; // create shortcut namespace
 #endif // YUTIYEFF_NO_NAMESPACE_SHORTCUT
@@ -30,141 +30,179 @@
 #pragma once
 
 #include "Yutiyeff.hpp"
-
+#include "Stats.inl"
+#include "Kernels.inl"
+#include "Simd.inl"
+#include "CodePointIterator.inl"
+#include "StringView.inl"
+#include "Transcoder.inl"
+#include "Conversion.inl"
+#include "SmallString.inl"
+#include "Column.inl"
+#include "CachedString.inl"
+#include "Rope.inl"
+#ifdef YUTIYEFF_CPP20
+#include "FixedString.inl"
+#endif // YUTIYEFF_CPP20
+#ifndef YUTIYEFF_NO_THREADS
+#include "Parallel.inl"
+#endif // YUTIYEFF_NO_THREADS
+#ifndef YUTIYEFF_NO_MAPPED_FILE
+#include "MappedFile.inl"
+#endif // YUTIYEFF_NO_MAPPED_FILE
+#ifdef YUTIYEFF_INDEX
+#include "CodePointIndex.inl"
+#endif // YUTIYEFF_INDEX
+
+#include <functional>
 #include <iostream>
+#include <stdexcept>
+#ifdef YUTIYEFF_CPP20
+#include <compare>
+#endif // YUTIYEFF_CPP20
 
 namespace yutiyeff
 {
 
+inline InvalidSequence::InvalidSequence(const std::size_t offset)
+	: std::invalid_argument("yutiyeff: invalid sequence at offset " + std::to_string(offset))
+	, m_offset{ offset }
+{
+}
+
 template <class T, class CharT>
 inline std::basic_string<char> String<T, CharT>::priv_utf8FromUtf32(const std::basic_string<char32_t>& utf32String)
 {
-	std::basic_string<char> result{};
-	const std::size_t sequenceLength{ utf32String.size() };
-	result.reserve(sequenceLength); // UTF-8 will almost definitely be at least at long as the UTF-32 (unless invalid values are discarded)
-	for (std::size_t i{ 0u }; i < sequenceLength; ++i)
-	{
-		const char32_t current{ utf32String[i] };
-
-		if (current <= 0x7F)
-			result.push_back(current & 0x7F);
-		else if (current <= 0x7FF)
-		{
-			result.push_back(static_cast<char>(0xc0 | ((current >> 6) & 0x1F)));
-			result.push_back(static_cast<char>(0x80 | (current & 0x3F)));
-		}
-		else if (current <= 0xFFFF)
-		{
-			result.push_back(static_cast<char>(0xe0 | ((current >> 12) & 0x0F)));
-			result.push_back(static_cast<char>(0x80 | ((current >> 6) & 0x3F)));
-			result.push_back(static_cast<char>(0x80 | (current & 0x3F)));
-		}
-		else if (current <= 0x10FFF)
-		{
-			result.push_back(static_cast<char>(0xF0 | ((current >> 18) & 0x07)));
-			result.push_back(static_cast<char>(0x80 | ((current >> 12) & 0x3F)));
-			result.push_back(static_cast<char>(0x80 | ((current >> 6) & 0x3F)));
-			result.push_back(static_cast<char>(0x80 | (current & 0x3F)));
-		}
-	}
-	return result;
+	return priv::convertStringExactly<char>(utf32String.data(), utf32String.data() + utf32String.size());
 }
 
 template <class T, class CharT>
 inline std::basic_string<char16_t> String<T, CharT>::priv_utf16FromUtf32(const std::basic_string<char32_t>& utf32String)
 {
-	std::basic_string<char16_t> result{};
-	const std::size_t sequenceLength{ utf32String.size() };
-	result.reserve(sequenceLength); // UTF-16 will almost definitely be at least at long as the UTF-32 (unless invalid values are discarded)
-	for (std::size_t i{ 0u }; i < sequenceLength; ++i)
-	{
-		char32_t current{ utf32String[i] };
-
-		if ((current > 0x10FFFF) || ((current >= 0xD800) && (current <= 0xDFFF))) // invalid ranges
-			continue;
-
-		if (current <= 0xFFFF) // single 16-bit value
-		{
-			result.push_back(static_cast<char16_t>(current));
-			continue;
-		}
-
-		current -= 0x10000; // now in range of 0x00000-0xFFFFF (this amount can be subtracted because 0x0000 - 0xFFFF would be encoded directly, not this way)
-		result.push_back(static_cast<char16_t>(((current >> 10) & 0x3FF) + 0xD800));
-		result.push_back(static_cast<char16_t>((current & 0x3FF) + 0xDC00));
-	}
-	return result;
+	return priv::convertStringExactly<char16_t>(utf32String.data(), utf32String.data() + utf32String.size());
 }
 
 template <class T, class CharT>
 inline std::basic_string<char32_t> String<T, CharT>::priv_utf32FromUtf8(const std::basic_string<char>& utf8String)
 {
-	std::basic_string<char32_t> result{};
-	const std::size_t sequenceLength{ utf8String.size() };
-	for (std::size_t i{ 0u }; i < sequenceLength; ++i)
-	{
-		const char32_t byte1{ static_cast<char32_t>(static_cast<unsigned char>(utf8String[i])) };
-		if (!(byte1 & 0x80))
-		{
-			result.push_back(byte1 & 0x7F);
-			continue;
-		}
-
-		if (++i >= sequenceLength)
-			break;
-		const char32_t byte2{ static_cast<char32_t>(utf8String[i]) };
-		if ((byte1 & 0xE0) == 0xD0)
-		{
-			result.push_back(((byte1 & 0x1F) << 6) | (byte2 & 0x3F));
-			continue;
-		}
-
-		if (++i >= sequenceLength)
-			break;
-		const char32_t byte3{ static_cast<char32_t>(utf8String[i]) };
-		if ((byte1 & 0xF0) == 0xE0)
-		{
-			result.push_back(((byte1 & 0x0F) << 12) | ((byte2 & 0x3F) << 6) | (byte3 & 0x3F));
-			continue;
-		}
-
-		if (++i >= sequenceLength)
-			break;
-		const char32_t byte4{ static_cast<char32_t>(utf8String[i]) };
-		if ((byte1 & 0xF8) == 0xF0)
-			result.push_back(((byte1 & 0x07) << 18) | ((byte2 & 0x3F) << 12) | ((byte3 & 0x3F) << 6) | (byte4 & 0x3F));
-	}
-	return result;
+	return priv::convertStringExactly<char32_t>(utf8String.data(), utf8String.data() + utf8String.size());
 }
 
 template <class T, class CharT>
 inline std::basic_string<char32_t> String<T, CharT>::priv_utf32FromUtf16(const std::basic_string<char16_t>& utf16String)
 {
-	std::basic_string<char32_t> result{};
-	const std::size_t sequenceLength{ utf16String.size() };
-	for (std::size_t i{ 0u }; i < sequenceLength; ++i)
-	{
-		char32_t unit1{ static_cast<char32_t>(utf16String[i]) };
-		if ((unit1 <= 0xD7FF) || ((unit1 >= 0xE000) && (unit1 <= 0xFFFF))) 
-		{
-			result.push_back(unit1);
-			continue;
-		}
-
-		if (++i >= sequenceLength)
-			break;
-
-		char32_t unit2{ static_cast<char32_t>(utf16String[i]) };
-		if (unit2 < 0xDC00)
-			continue;
-
-		unit1 -= 0xD800;
-		unit2 -= 0xDC00;
-		result.push_back(((unit1 & 0x3FF) << 10) | (unit2 & 0x3FF));
-	}
+	return priv::convertStringExactly<char32_t>(utf16String.data(), utf16String.data() + utf16String.size());
+}
+
+template <class T, class CharT>
+inline std::basic_string<char> String<T, CharT>::priv_utf8FromUtf16(const std::basic_string<char16_t>& utf16String)
+{
+	return priv::convertStringExactly<char>(utf16String.data(), utf16String.data() + utf16String.size());
+}
+
+template <class T, class CharT>
+inline std::basic_string<char16_t> String<T, CharT>::priv_utf16FromUtf8(const std::basic_string<char>& utf8String)
+{
+	return priv::convertStringExactly<char16_t>(utf8String.data(), utf8String.data() + utf8String.size());
+}
+
+template <class T, class CharT>
+inline T String<T, CharT>::fromSequence(std::basic_string<CharT>&& sequence, const ErrorPolicy errorPolicy, std::size_t* const errorOffset)
+{
+	T result;
+	result.m_sequence = priv::validSequence(std::move(sequence), errorPolicy, errorOffset);
 	return result;
 }
 
+template <class T, class CharT>
+template <class InCharT>
+inline T String<T, CharT>::fromSequence(const std::basic_string<InCharT>& sequence, const ErrorPolicy errorPolicy, std::size_t* const errorOffset)
+{
+	return fromSequence(StringView<InCharT>(sequence), errorPolicy, errorOffset);
+}
+
+template <class T, class CharT>
+template <class InCharT>
+inline T String<T, CharT>::fromSequence(const StringView<InCharT>& sequence, const ErrorPolicy errorPolicy, std::size_t* const errorOffset)
+{
+	T result;
+	result.m_sequence = priv::validSequence<CharT>(sequence.getData(), sequence.getData() + sequence.getDataSize(), errorPolicy, errorOffset);
+	return result;
+}
+
+template <class T, class CharT>
+inline void String<T, CharT>::swap(T& other)
+{
+	std::swap(m_sequence, other.m_sequence);
+#ifdef YUTIYEFF_INDEX
+	std::swap(m_index, other.m_index);
+#endif // YUTIYEFF_INDEX
+}
+
+template <class T, class CharT>
+template <class FromT, class FromCharT>
+inline void String<T, CharT>::assign(const String<FromT, FromCharT>& string)
+{
+	if (static_cast<const void*>(&string) == this)
+		return;
+	convertInto(string.getView(), m_sequence);
+	priv_resetIndex();
+}
+
+template <class T, class CharT>
+inline typename String<T, CharT>::const_iterator String<T, CharT>::begin() const
+{
+	const CharT* const sequenceEnd{ m_sequence.data() + m_sequence.size() };
+	const CharT* const first{ priv::findCodePoint(m_sequence.data(), sequenceEnd, 0u) };
+	return const_iterator(first, first, sequenceEnd);
+}
+
+template <class T, class CharT>
+inline typename String<T, CharT>::const_iterator String<T, CharT>::end() const
+{
+	const CharT* const sequenceEnd{ m_sequence.data() + m_sequence.size() };
+	return const_iterator(sequenceEnd, priv::findCodePoint(m_sequence.data(), sequenceEnd, 0u), sequenceEnd);
+}
+
+template <class T, class CharT>
+inline std::size_t String<T, CharT>::priv_codePointOffset(const std::size_t index) const
+{
+#ifdef YUTIYEFF_INDEX
+	return m_index.find(m_sequence, index);
+#else
+	const CharT* const begin{ m_sequence.data() };
+	return static_cast<std::size_t>(priv::findCodePoint(begin, begin + m_sequence.size(), index) - begin);
+#endif // YUTIYEFF_INDEX
+}
+
+template <class T, class CharT>
+inline std::size_t String<T, CharT>::priv_insertOffset(const std::size_t index) const
+{
+	const std::size_t offset{ priv_codePointOffset(index) };
+	if ((offset == m_sequence.size()) && (index > length())) // only counted when the offset is at the end
+		throw std::out_of_range("yutiyeff: insert offset is past the end of the string");
+	return offset;
+}
+
+template <class T, class CharT>
+inline void String<T, CharT>::priv_resetIndex()
+{
+#ifdef YUTIYEFF_INDEX
+	m_index.reset();
+#endif // YUTIYEFF_INDEX
+}
+
+template <class T, class CharT>
+inline void String<T, CharT>::priv_shiftIndex(const std::size_t index, const std::ptrdiff_t difference)
+{
+#ifdef YUTIYEFF_INDEX
+	m_index.shift(index, difference);
+#else
+	(void)index;
+	(void)difference;
+#endif // YUTIYEFF_INDEX
+}
+
 
 
 
@@ -218,27 +256,34 @@ inline Utf8String::Utf8String(const char32_t cU32)
 
 inline Utf8String::Utf8String(const std::basic_string<char>& u8String)
 {
-	m_sequence = u8String;
+	m_sequence = priv::validSequence<char>(u8String.data(), u8String.data() + u8String.size());
+}
+
+inline Utf8String::Utf8String(std::basic_string<char>&& u8String)
+{
+	m_sequence = priv::validSequence(std::move(u8String));
 }
 
 #ifdef YUTIYEFF_CPP20
 inline Utf8String::Utf8String(const std::basic_string<char8_t>& u8String)
 {
 	const std::size_t size{ u8String.size() };
-	m_sequence.resize(size);
+	std::basic_string<char> s;
+	s.resize(size);
 	for (std::size_t i{ 0u }; i < size; ++i)
-		m_sequence[i] = static_cast<char>(u8String[i]);
+		s[i] = static_cast<char>(u8String[i]);
+	m_sequence = priv::validSequence(std::move(s));
 }
 #endif // YUTIYEFF_CPP20
 
 inline Utf8String::Utf8String(const std::basic_string<char16_t>& u16String)
 {
-	*this = priv_utf8FromUtf32(priv_utf32FromUtf16(u16String));
+	m_sequence = priv::validSequence<char>(u16String.data(), u16String.data() + u16String.size());
 }
 
 inline Utf8String::Utf8String(const std::basic_string<char32_t>& u32String)
 {
-	*this = priv_utf8FromUtf32(u32String);
+	m_sequence = priv::validSequence<char>(u32String.data(), u32String.data() + u32String.size());
 }
 
 inline Utf8String::Utf8String(const Utf8String& utf8String)
@@ -246,9 +291,15 @@ inline Utf8String::Utf8String(const Utf8String& utf8String)
 	*this = utf8String;
 }
 
+inline Utf8String::Utf8String(Utf8String&& utf8String) noexcept
+	: String(std::move(utf8String))
+{
+	utf8String.priv_resetIndex();
+}
+
 inline Utf8String::Utf8String(const Utf16String& utf16String)
 {
-	m_sequence = priv_utf8FromUtf32(priv_utf32FromUtf16(utf16String.getSequence()));
+	m_sequence = priv_utf8FromUtf16(utf16String.getSequence());
 }
 
 inline Utf8String::Utf8String(const Utf32String& utf32String)
@@ -256,72 +307,116 @@ inline Utf8String::Utf8String(const Utf32String& utf32String)
 	m_sequence = priv_utf8FromUtf32(utf32String.getSequence());
 }
 
+inline Utf8String::Utf8String(const Utf8StringView& utf8StringView)
+{
+	m_sequence = priv::validSequence<char>(utf8StringView.getData(), utf8StringView.getData() + utf8StringView.getDataSize());
+}
+
+inline Utf8String::Utf8String(const Utf16StringView& utf16StringView)
+{
+	m_sequence = priv::validSequence<char>(utf16StringView.getData(), utf16StringView.getData() + utf16StringView.getDataSize());
+}
+
+inline Utf8String::Utf8String(const Utf32StringView& utf32StringView)
+{
+	m_sequence = priv::validSequence<char>(utf32StringView.getData(), utf32StringView.getData() + utf32StringView.getDataSize());
+}
+
 inline Utf8String& Utf8String::operator=(const Utf8String& utf8String)
 {
 	m_sequence = utf8String.m_sequence;
+	priv_resetIndex();
+	return *this;
+}
+
+inline Utf8String& Utf8String::operator=(Utf8String&& utf8String) noexcept
+{
+	m_sequence = std::move(utf8String.m_sequence);
+	priv_resetIndex();
+	utf8String.priv_resetIndex();
 	return *this;
 }
 
-inline Utf8String Utf8String::operator+(const Utf8String& utf8String) const
+inline Utf8String Utf8String::operator+(const Utf8String& utf8String) const &
 {
-	return Utf8String{ m_sequence + utf8String.m_sequence };
+	return fromSequence(m_sequence + utf8String.m_sequence, ErrorPolicy::AssumeValid);
+}
+
+inline Utf8String Utf8String::operator+(const Utf8String& utf8String) &&
+{
+	*this += utf8String;
+	return std::move(*this);
 }
 
 inline Utf8String& Utf8String::operator+=(const Utf8String& utf8String)
 {
 	m_sequence += utf8String.m_sequence;
+	priv_resetIndex();
 	return *this;
 }
 
 inline std::size_t Utf8String::find(const Utf8String& utf8String, const std::size_t offset) const
 {
-	return Utf32String(*this).find(Utf32String(utf8String), offset);
+	const std::basic_string<char>& needle{ utf8String.m_sequence };
+	if (needle.empty())
+		return (offset <= length()) ? offset : std::basic_string<char>::npos;
+
+	const char* const begin{ m_sequence.data() + priv_codePointOffset(offset) };
+	const char* const end{ m_sequence.data() + m_sequence.size() };
+	const char* const match{ priv::findSequence(begin, end, needle.data(), needle.size()) }; // both are valid so any match is of whole code points
+	return (match != end) ? (offset + priv::codePointCountUtf8(begin, match)) : std::basic_string<char>::npos;
 }
 
 inline Utf8String Utf8String::substr(const std::size_t length, const std::size_t offset) const
 {
-	const std::size_t sequenceLength{ m_sequence.size() };
-	for (std::size_t pos{ 0u }, start{ 0u }, end{ 0u }; end < sequenceLength; ++end)
-	{
-		if (pos == offset)
-			start = end;
-		if ((static_cast<unsigned char>(m_sequence[end]) & 0xc0) != 0x80)
-			++pos;
-		if (pos > (length + offset))
-			return m_sequence.substr(start, end - start);
-		if (end + 1u == sequenceLength)
-		{
-			if (offset != 0u)
-				return m_sequence.substr(start, end + 1u - start);
-		}
-	}
-	return m_sequence;
+	const std::size_t start{ priv_codePointOffset(offset) };
+	const char* const begin{ m_sequence.data() + start };
+	const char* const end{ priv::findCodePoint(begin, m_sequence.data() + m_sequence.size(), length) };
+	return fromSequence(m_sequence.substr(start, static_cast<std::size_t>(end - begin)), ErrorPolicy::AssumeValid);
 }
 
 inline void Utf8String::insert(const std::size_t offset, const Utf8String& utf8String)
 {
-	m_sequence = priv_utf8FromUtf32(priv_utf32FromUtf8(m_sequence).insert(offset, priv_utf32FromUtf8(utf8String.m_sequence)));
+	m_sequence.insert(priv_insertOffset(offset), utf8String.m_sequence);
+	priv_resetIndex();
 }
 
 inline void Utf8String::insert(const std::size_t offset, const char32_t char32)
 {
-	Utf32String u32{ Utf32String(*this) };
-	u32.insert(offset, char32);
-	m_sequence = priv_utf8FromUtf32(u32.getSequence());
+	char encoded[4];
+	char* encodedEnd{ encoded };
+	priv::encodeUtf8(char32, encodedEnd);
+	m_sequence.insert(priv_insertOffset(offset), encoded, static_cast<std::size_t>(encodedEnd - encoded));
+	priv_resetIndex();
 }
 
 inline void Utf8String::erase(const std::size_t startPos, const std::size_t length)
 {
-	Utf32String u32{ Utf32String(*this) };
-	u32.erase(startPos, length);
-	m_sequence = priv_utf8FromUtf32(u32.getSequence());
+	const std::size_t start{ priv_codePointOffset(startPos) };
+	if (start == m_sequence.size())
+		return;
+	const char* const begin{ m_sequence.data() + start };
+	const char* const end{ (length == 0u) ? (m_sequence.data() + m_sequence.size()) : priv::findCodePoint(begin, m_sequence.data() + m_sequence.size(), length) };
+	m_sequence.erase(start, static_cast<std::size_t>(end - begin));
+	priv_resetIndex();
 }
 
 inline void Utf8String::set(const std::size_t index, const char32_t char32)
 {
-	Utf32String u32{ Utf32String(*this) };
-	u32.set(index, char32);
-	m_sequence = priv_utf8FromUtf32(u32.getSequence());
+	const std::size_t start{ priv_codePointOffset(index) };
+	if (start == m_sequence.size())
+		return;
+	const char* const begin{ m_sequence.data() + start };
+	const std::size_t length{ static_cast<std::size_t>(priv::findCodePoint(begin, m_sequence.data() + m_sequence.size(), 1u) - begin) };
+	char encoded[4];
+	char* encodedEnd{ encoded };
+	priv::encodeUtf8(char32, encodedEnd);
+	const std::size_t encodedLength{ static_cast<std::size_t>(encodedEnd - encoded) };
+	m_sequence.replace(start, length, encoded, encodedLength);
+	if (encodedLength == 0u) // the code point could not be encoded so it was removed
+		priv_resetIndex();
+	else
+		priv_shiftIndex(index, static_cast<std::ptrdiff_t>(encodedLength) - static_cast<std::ptrdiff_t>(length));
 }
 
 inline void Utf8String::reserve(std::size_t dataPointsCap)
@@ -341,37 +436,26 @@ inline std::string Utf8String::getString() const
 
 inline std::string Utf8String::getNonUnicodeString() const
 {
-	std::string s{};
-	const std::size_t sequenceLength{ m_sequence.size() };
-	for (std::size_t i{ 0u }; i < sequenceLength; ++i)
-	{
-		const unsigned char element{ static_cast<unsigned char>(m_sequence[i]) };
-		if ((element & 0x80) == 0x00)
-			s.push_back(static_cast<char>(element));
-	}
-	return s;
+	const priv::StatsScope statsScope{ StatsOperation::Output };
+	return priv::nonUnicodeString(m_sequence.data(), m_sequence.data() + m_sequence.size());
 }
 
 inline std::size_t Utf8String::length() const
 {
-	const std::size_t sequenceLength{ m_sequence.size() };
-	std::size_t count{ 0u };
-	for (std::size_t i{ 0u }; i < sequenceLength; ++i)
-	{
-		if ((static_cast<unsigned char>(m_sequence[i]) & 0xc0) != 0x80)
-			++count;
-	}
-	return count;
+	return priv::codePointCountUtf8(m_sequence.data(), m_sequence.data() + m_sequence.size());
 }
 
 inline char32_t Utf8String::operator[](const std::size_t index) const
 {
-	return (Utf32String(*this))[index];
+	const char* const end{ m_sequence.data() + m_sequence.size() };
+	const char* const current{ m_sequence.data() + priv_codePointOffset(index) };
+	return (current != end) ? priv::validCodePointAt(current) : 0u;
 }
 
 inline void Utf8String::clear()
 {
 	m_sequence.clear();
+	priv_resetIndex();
 }
 
 
@@ -432,7 +516,7 @@ inline Utf16String::Utf16String(const char32_t cU32)
 
 inline Utf16String::Utf16String(const std::basic_string<char>& u8String)
 {
-	*this = priv_utf16FromUtf32(priv_utf32FromUtf8(u8String));
+	m_sequence = priv::validSequence<char16_t>(u8String.data(), u8String.data() + u8String.size());
 }
 
 #ifdef YUTIYEFF_CPP20
@@ -443,23 +527,28 @@ inline Utf16String::Utf16String(const std::basic_string<char8_t>& u8String)
 	s.resize(size);
 	for (std::size_t i{ 0u }; i < size; ++i)
 		s[i] = static_cast<char>(u8String[i]);
-	*this = priv_utf16FromUtf32(priv_utf32FromUtf8(s));
+	m_sequence = priv::validSequence<char16_t>(s.data(), s.data() + s.size());
 }
 #endif // YUTIYEFF_CPP20
 
 inline Utf16String::Utf16String(const std::basic_string<char16_t>& u16String)
 {
-	m_sequence = u16String;
+	m_sequence = priv::validSequence<char16_t>(u16String.data(), u16String.data() + u16String.size());
+}
+
+inline Utf16String::Utf16String(std::basic_string<char16_t>&& u16String)
+{
+	m_sequence = priv::validSequence(std::move(u16String));
 }
 
 inline Utf16String::Utf16String(const std::basic_string<char32_t>& u32String)
 {
-	*this = priv_utf16FromUtf32(u32String);
+	m_sequence = priv::validSequence<char16_t>(u32String.data(), u32String.data() + u32String.size());
 }
 
 inline Utf16String::Utf16String(const Utf8String& utf8String)
 {
-	*this = priv_utf16FromUtf32(priv_utf32FromUtf8(utf8String));
+	m_sequence = priv_utf16FromUtf8(utf8String.getSequence());
 }
 
 inline Utf16String::Utf16String(const Utf16String& utf16String)
@@ -467,78 +556,127 @@ inline Utf16String::Utf16String(const Utf16String& utf16String)
 	*this = utf16String;
 }
 
+inline Utf16String::Utf16String(Utf16String&& utf16String) noexcept
+	: String(std::move(utf16String))
+{
+	utf16String.priv_resetIndex();
+}
+
 inline Utf16String::Utf16String(const Utf32String& utf32String)
 {
-	*this = priv_utf16FromUtf32(utf32String.getSequence());
+	m_sequence = priv_utf16FromUtf32(utf32String.getSequence());
+}
+
+inline Utf16String::Utf16String(const Utf8StringView& utf8StringView)
+{
+	m_sequence = priv::validSequence<char16_t>(utf8StringView.getData(), utf8StringView.getData() + utf8StringView.getDataSize());
+}
+
+inline Utf16String::Utf16String(const Utf16StringView& utf16StringView)
+{
+	m_sequence = priv::validSequence<char16_t>(utf16StringView.getData(), utf16StringView.getData() + utf16StringView.getDataSize());
+}
+
+inline Utf16String::Utf16String(const Utf32StringView& utf32StringView)
+{
+	m_sequence = priv::validSequence<char16_t>(utf32StringView.getData(), utf32StringView.getData() + utf32StringView.getDataSize());
 }
 
 inline Utf16String& Utf16String::operator=(const Utf16String& utf16String)
 {
 	m_sequence = utf16String.m_sequence;
+	priv_resetIndex();
 	return *this;
 }
 
-inline Utf16String Utf16String::operator+(const Utf16String& utf16String) const
+inline Utf16String& Utf16String::operator=(Utf16String&& utf16String) noexcept
+{
+	m_sequence = std::move(utf16String.m_sequence);
+	priv_resetIndex();
+	utf16String.priv_resetIndex();
+	return *this;
+}
+
+inline Utf16String Utf16String::operator+(const Utf16String& utf16String) const &
+{
+	return fromSequence(m_sequence + utf16String.m_sequence, ErrorPolicy::AssumeValid);
+}
+
+inline Utf16String Utf16String::operator+(const Utf16String& utf16String) &&
 {
-	return Utf16String{ m_sequence + utf16String.m_sequence };
+	*this += utf16String;
+	return std::move(*this);
 }
 
 inline Utf16String& Utf16String::operator+=(const Utf16String& utf16String)
 {
 	m_sequence += utf16String.m_sequence;
+	priv_resetIndex();
 	return *this;
 }
 
 inline std::size_t Utf16String::find(const Utf16String& utf16String, const std::size_t offset) const
 {
-	return Utf32String(*this).find(Utf32String(utf16String), offset);
+	const std::basic_string<char16_t>& needle{ utf16String.m_sequence };
+	if (needle.empty())
+		return (offset <= length()) ? offset : std::basic_string<char16_t>::npos;
+
+	const char16_t* const begin{ m_sequence.data() + priv_codePointOffset(offset) };
+	const char16_t* const end{ m_sequence.data() + m_sequence.size() };
+	const char16_t* const match{ priv::findSequence(begin, end, needle.data(), needle.size()) }; // both are valid so any match is of whole code points
+	return (match != end) ? (offset + priv::codePointCountUtf16(begin, match)) : std::basic_string<char16_t>::npos;
 }
 
 inline Utf16String Utf16String::substr(const std::size_t length, const std::size_t offset) const
 {
-	const std::size_t sequenceLength{ m_sequence.size() };
-	for (std::size_t pos{ 0u }, start{ 0u }, end{ 0u }; end < sequenceLength; ++end)
-	{
-		if (pos == offset)
-			start = end;
-		const char16_t element{ m_sequence[end] };
-		if ((element <= 0xDBFF) || (element >= 0xE000))
-			++pos;
-		if (pos > (length + offset))
-			return m_sequence.substr(start, end - start);
-		if (end + 1u == sequenceLength)
-		{
-			if (offset != 0u)
-				return m_sequence.substr(start, end + 1u - start);
-		}
-	}
-	return m_sequence;
+	const std::size_t start{ priv_codePointOffset(offset) };
+	const char16_t* const begin{ m_sequence.data() + start };
+	const char16_t* const end{ priv::findCodePoint(begin, m_sequence.data() + m_sequence.size(), length) };
+	return fromSequence(m_sequence.substr(start, static_cast<std::size_t>(end - begin)), ErrorPolicy::AssumeValid);
 }
 
 inline void Utf16String::insert(const std::size_t offset, const Utf16String& utf16String)
 {
-	m_sequence = priv_utf16FromUtf32(priv_utf32FromUtf16(m_sequence).insert(offset, priv_utf32FromUtf16(utf16String.m_sequence)));
+	m_sequence.insert(priv_insertOffset(offset), utf16String.m_sequence);
+	priv_resetIndex();
 }
 
 inline void Utf16String::insert(const std::size_t offset, const char32_t char32)
 {
-	Utf32String u32{ Utf32String(*this) };
-	u32.insert(offset, char32);
-	m_sequence = priv_utf16FromUtf32(u32.getSequence());
+	char16_t encoded[2];
+	char16_t* encodedEnd{ encoded };
+	priv::encodeUtf16(char32, encodedEnd);
+	m_sequence.insert(priv_insertOffset(offset), encoded, static_cast<std::size_t>(encodedEnd - encoded));
+	priv_resetIndex();
 }
 
 inline void Utf16String::erase(const std::size_t startPos, const std::size_t length)
 {
-	Utf32String u32{ Utf32String(*this) };
-	u32.erase(startPos, length);
-	m_sequence = priv_utf16FromUtf32(u32.getSequence());
+	const std::size_t start{ priv_codePointOffset(startPos) };
+	if (start == m_sequence.size())
+		return;
+	const char16_t* const begin{ m_sequence.data() + start };
+	const char16_t* const end{ (length == 0u) ? (m_sequence.data() + m_sequence.size()) : priv::findCodePoint(begin, m_sequence.data() + m_sequence.size(), length) };
+	m_sequence.erase(start, static_cast<std::size_t>(end - begin));
+	priv_resetIndex();
 }
 
 inline void Utf16String::set(const std::size_t index, const char32_t char32)
 {
-	Utf32String u32{ Utf32String(*this) };
-	u32.set(index, char32);
-	m_sequence = priv_utf16FromUtf32(u32.getSequence());
+	const std::size_t start{ priv_codePointOffset(index) };
+	if (start == m_sequence.size())
+		return;
+	const char16_t* const begin{ m_sequence.data() + start };
+	const std::size_t length{ static_cast<std::size_t>(priv::findCodePoint(begin, m_sequence.data() + m_sequence.size(), 1u) - begin) };
+	char16_t encoded[2];
+	char16_t* encodedEnd{ encoded };
+	priv::encodeUtf16(char32, encodedEnd);
+	const std::size_t encodedLength{ static_cast<std::size_t>(encodedEnd - encoded) };
+	m_sequence.replace(start, length, encoded, encodedLength);
+	if (encodedLength == 0u) // the code point could not be encoded so it was removed
+		priv_resetIndex();
+	else
+		priv_shiftIndex(index, static_cast<std::ptrdiff_t>(encodedLength) - static_cast<std::ptrdiff_t>(length));
 }
 
 inline Utf16String::operator std::string() const
@@ -548,33 +686,19 @@ inline Utf16String::operator std::string() const
 
 inline std::string Utf16String::getString() const
 {
-	return priv_utf8FromUtf32(priv_utf32FromUtf16(m_sequence));
+	const priv::StatsScope statsScope{ StatsOperation::Output };
+	return priv_utf8FromUtf16(m_sequence);
 }
 
 inline std::string Utf16String::getNonUnicodeString() const
 {
-	std::string s{};
-	const std::size_t sequenceLength{ m_sequence.size() };
-	for (std::size_t i{ 0u }; i < sequenceLength; ++i)
-	{
-		const char16_t element{ m_sequence[i] };
-		if (element <= 0x7F)
-			s.push_back(static_cast<char>(static_cast<unsigned char>(element)));
-	}
-	return s;
+	const priv::StatsScope statsScope{ StatsOperation::Output };
+	return priv::nonUnicodeString(m_sequence.data(), m_sequence.data() + m_sequence.size());
 }
 
 inline std::size_t Utf16String::length() const
 {
-	const std::size_t sequenceLength{ m_sequence.size() };
-	std::size_t count{ 0u };
-	for (std::size_t i{ 0u }; i < sequenceLength; ++i)
-	{
-		const char16_t element{ m_sequence[i] };
-		if ((element <= 0xDBFF) || (element >= 0xE000))
-			++count;
-	}
-	return count;
+	return priv::codePointCountUtf16(m_sequence.data(), m_sequence.data() + m_sequence.size());
 }
 
 inline void Utf16String::reserve(std::size_t dataPointsCap)
@@ -584,12 +708,15 @@ inline void Utf16String::reserve(std::size_t dataPointsCap)
 
 inline char32_t Utf16String::operator[](const std::size_t index) const
 {
-	return (Utf32String(*this))[index];
+	const char16_t* const end{ m_sequence.data() + m_sequence.size() };
+	const char16_t* const current{ m_sequence.data() + priv_codePointOffset(index) };
+	return (current != end) ? priv::validCodePointAt(current) : 0u;
 }
 
 inline void Utf16String::clear()
 {
 	m_sequence.clear();
+	priv_resetIndex();
 }
 
 
@@ -648,7 +775,7 @@ inline Utf32String::Utf32String(const char32_t cU32)
 
 inline Utf32String::Utf32String(const std::basic_string<char>& u8String)
 {
-	*this = priv_utf32FromUtf8(u8String);
+	m_sequence = priv::validSequence<char32_t>(u8String.data(), u8String.data() + u8String.size());
 }
 
 #ifdef YUTIYEFF_CPP20
@@ -659,28 +786,33 @@ inline Utf32String::Utf32String(const std::basic_string<char8_t>& u8String)
 	s.resize(size);
 	for (std::size_t i{ 0u }; i < size; ++i)
 		s[i] = static_cast<char>(u8String[i]);
-	*this = priv_utf32FromUtf8(s);
+	m_sequence = priv::validSequence<char32_t>(s.data(), s.data() + s.size());
 }
 #endif // YUTIYEFF_CPP20
 
 inline Utf32String::Utf32String(const std::basic_string<char16_t>& u16String)
 {
-	*this = priv_utf32FromUtf16(u16String);
+	m_sequence = priv::validSequence<char32_t>(u16String.data(), u16String.data() + u16String.size());
 }
 
 inline Utf32String::Utf32String(const std::basic_string<char32_t>& u32String)
 {
-	m_sequence = u32String;
+	m_sequence = priv::validSequence<char32_t>(u32String.data(), u32String.data() + u32String.size());
+}
+
+inline Utf32String::Utf32String(std::basic_string<char32_t>&& u32String)
+{
+	m_sequence = priv::validSequence(std::move(u32String));
 }
 
 inline Utf32String::Utf32String(const Utf8String& utf8String)
 {
-	*this = priv_utf32FromUtf8(utf8String.getSequence());
+	m_sequence = priv_utf32FromUtf8(utf8String.getSequence());
 }
 
 inline Utf32String::Utf32String(const Utf16String& utf16String)
 {
-	*this = priv_utf32FromUtf16(utf16String.getSequence());
+	m_sequence = priv_utf32FromUtf16(utf16String.getSequence());
 }
 
 inline Utf32String::Utf32String(const Utf32String& utf32String)
@@ -688,15 +820,50 @@ inline Utf32String::Utf32String(const Utf32String& utf32String)
 	*this = utf32String;
 }
 
+inline Utf32String::Utf32String(Utf32String&& utf32String) noexcept
+	: String(std::move(utf32String))
+{
+	utf32String.priv_resetIndex();
+}
+
+inline Utf32String::Utf32String(const Utf8StringView& utf8StringView)
+{
+	m_sequence = priv::validSequence<char32_t>(utf8StringView.getData(), utf8StringView.getData() + utf8StringView.getDataSize());
+}
+
+inline Utf32String::Utf32String(const Utf16StringView& utf16StringView)
+{
+	m_sequence = priv::validSequence<char32_t>(utf16StringView.getData(), utf16StringView.getData() + utf16StringView.getDataSize());
+}
+
+inline Utf32String::Utf32String(const Utf32StringView& utf32StringView)
+{
+	m_sequence = priv::validSequence<char32_t>(utf32StringView.getData(), utf32StringView.getData() + utf32StringView.getDataSize());
+}
+
 inline Utf32String& Utf32String::operator=(const Utf32String& utf32String)
 {
 	m_sequence = utf32String.m_sequence;
 	return *this;
 }
 
-inline Utf32String Utf32String::operator+(const Utf32String& utf32String) const
+inline Utf32String& Utf32String::operator=(Utf32String&& utf32String) noexcept
+{
+	m_sequence = std::move(utf32String.m_sequence);
+	priv_resetIndex();
+	utf32String.priv_resetIndex();
+	return *this;
+}
+
+inline Utf32String Utf32String::operator+(const Utf32String& utf32String) const &
+{
+	return fromSequence(m_sequence + utf32String.m_sequence, ErrorPolicy::AssumeValid);
+}
+
+inline Utf32String Utf32String::operator+(const Utf32String& utf32String) &&
 {
-	return Utf32String{ m_sequence + utf32String.m_sequence };
+	*this += utf32String;
+	return std::move(*this);
 }
 
 inline Utf32String& Utf32String::operator+=(const Utf32String& utf32String)
@@ -712,7 +879,7 @@ inline std::size_t Utf32String::find(const Utf32String& utf32String, const std::
 
 inline Utf32String Utf32String::substr(const std::size_t length, const std::size_t offset) const
 {
-	return Utf32String(m_sequence.substr(offset, length));
+	return fromSequence(m_sequence.substr(offset, length), ErrorPolicy::AssumeValid);
 }
 
 inline void Utf32String::insert(const std::size_t offset, const Utf32String& utf32String)
@@ -722,6 +889,10 @@ inline void Utf32String::insert(const std::size_t offset, const Utf32String& utf
 
 inline void Utf32String::insert(const std::size_t offset, const char32_t char32)
 {
+	if (offset > m_sequence.size()) // checked first, as it is by the other types
+		throw std::out_of_range("yutiyeff: insert offset is past the end of the string");
+	if (!priv::isValidCodePoint(char32)) // discarded, as it is by the other types
+		return;
 	m_sequence.insert(offset, 1u, char32);
 }
 
@@ -736,7 +907,10 @@ inline void Utf32String::erase(const std::size_t startPos, std::size_t length)
 
 inline void Utf32String::set(const std::size_t index, const char32_t char32)
 {
-	m_sequence[index] = char32;
+	if (priv::isValidCodePoint(char32))
+		m_sequence[index] = char32;
+	else // the code point could not be encoded so it is removed (as it is by the other types)
+		m_sequence.erase(index, 1u);
 }
 
 inline Utf32String::operator std::string() const
@@ -746,20 +920,14 @@ inline Utf32String::operator std::string() const
 
 inline std::string Utf32String::getString() const
 {
+	const priv::StatsScope statsScope{ StatsOperation::Output };
 	return priv_utf8FromUtf32(m_sequence);
 }
 
 inline std::string Utf32String::getNonUnicodeString() const
 {
-	std::string s{};
-	const std::size_t sequenceLength{ m_sequence.size() };
-	for (std::size_t i{ 0u }; i < sequenceLength; ++i)
-	{
-		const char32_t element{ m_sequence[i] };
-		if (element <= 0x7F)
-			s.push_back(static_cast<char>(static_cast<unsigned char>(element)));
-	}
-	return s;
+	const priv::StatsScope statsScope{ StatsOperation::Output };
+	return priv::nonUnicodeString(m_sequence.data(), m_sequence.data() + m_sequence.size());
 }
 
 inline std::size_t Utf32String::length() const
@@ -797,6 +965,8 @@ inline void Utf32String::clear()
 template <class LhsUtfStringT, class RhsUtfStringT>
 inline void swap(LhsUtfStringT& lhs, RhsUtfStringT& rhs)
 {
+	const priv::StatsScope statsScope{ StatsOperation::Swap };
+
 	// first convert both to UTF-32
 	Utf32String lhs32{ lhs };
 	Utf32String rhs32{ rhs };
@@ -811,13 +981,80 @@ inline void swap(LhsUtfStringT& lhs, RhsUtfStringT& rhs)
 
 
 
+// VIEWS OF OPERANDS
+
+namespace priv
+{
+
+// a view of anything that can be compared with a string (so that it is compared without being copied or converted)
+template <class T, class CharT>
+inline StringView<CharT> viewOf(const String<T, CharT>& string) { return string.getView(); }
+template <class CharT>
+inline StringView<CharT> viewOf(const StringView<CharT>& view) { return view; }
+template <class CharT>
+inline StringView<CharT> viewOf(const std::basic_string<CharT>& sequence) { return StringView<CharT>(sequence); }
+template <class CharT, std::size_t inlineCapacity, class Allocator>
+inline StringView<CharT> viewOf(const SmallString<CharT, inlineCapacity, Allocator>& string) { return string.getView(); }
+template <class T>
+inline auto viewOf(const CachedString<T>& string) -> decltype(string.getView()) { return string.getView(); }
+#ifdef YUTIYEFF_CPP20
+template <class CharT, std::size_t size>
+inline StringView<CharT> viewOf(const FixedString<CharT, size>& string) { return string.getView(); }
+#endif // YUTIYEFF_CPP20
+inline Utf8StringView viewOf(const char* const cString) { return Utf8StringView(cString); }
+inline Utf16StringView viewOf(const char16_t* const cString) { return Utf16StringView(cString); }
+inline Utf32StringView viewOf(const char32_t* const cString) { return Utf32StringView(cString); }
+inline Utf8StringView viewOf(const char& character) { return Utf8StringView(&character, 1u); }
+inline Utf16StringView viewOf(const char16_t& character) { return Utf16StringView(&character, 1u); }
+inline Utf32StringView viewOf(const char32_t& character) { return Utf32StringView(&character, 1u); }
+#ifdef YUTIYEFF_CPP20
+inline Utf8StringView viewOf(const std::basic_string<char8_t>& sequence) { return Utf8StringView(reinterpret_cast<const char*>(sequence.data()), sequence.size()); }
+inline Utf8StringView viewOf(const char8_t* const cString) { return Utf8StringView(reinterpret_cast<const char*>(cString)); }
+inline Utf8StringView viewOf(const char8_t& character) { return Utf8StringView(reinterpret_cast<const char*>(&character), 1u); }
+#endif // YUTIYEFF_CPP20
+
+template <class LhsCharT, class RhsCharT>
+inline int compareViews(const StringView<LhsCharT>& lhs, const StringView<RhsCharT>& rhs)
+{
+	return compareCodePoints(lhs.getData(), lhs.getData() + lhs.getDataSize(), rhs.getData(), rhs.getData() + rhs.getDataSize());
+}
+
+template <class LhsCharT, class RhsCharT>
+inline bool equalViews(const StringView<LhsCharT>& lhs, const StringView<RhsCharT>& rhs)
+{
+	return equalCodePoints(lhs.getData(), lhs.getData() + lhs.getDataSize(), rhs.getData(), rhs.getData() + rhs.getDataSize());
+}
+
+} // namespace priv
+
+
+
 // EXTERNAL OPERATORS (internal namespace)
+// strings (and views, standard strings and C strings) of any encodings are compared by code point without being converted.
+// these only exist for operands that priv::viewOf accepts
+
+template <class LhsUtfStringT, class RhsUtfStringT>
+inline auto operator==(const LhsUtfStringT& lhs, const RhsUtfStringT& rhs) -> decltype(priv::viewOf(lhs), priv::viewOf(rhs), true) { return priv::equalViews(priv::viewOf(lhs), priv::viewOf(rhs)); }
+
+template <class LhsUtfStringT, class RhsUtfStringT>
+inline auto operator!=(const LhsUtfStringT& lhs, const RhsUtfStringT& rhs) -> decltype(priv::viewOf(lhs), priv::viewOf(rhs), true) { return !(lhs == rhs); }
+
+template <class LhsUtfStringT, class RhsUtfStringT>
+inline auto operator<(const LhsUtfStringT& lhs, const RhsUtfStringT& rhs) -> decltype(priv::viewOf(lhs), priv::viewOf(rhs), true) { return priv::compareViews(priv::viewOf(lhs), priv::viewOf(rhs)) < 0; }
+
+template <class LhsUtfStringT, class RhsUtfStringT>
+inline auto operator>(const LhsUtfStringT& lhs, const RhsUtfStringT& rhs) -> decltype(priv::viewOf(lhs), priv::viewOf(rhs), true) { return priv::compareViews(priv::viewOf(lhs), priv::viewOf(rhs)) > 0; }
+
+template <class LhsUtfStringT, class RhsUtfStringT>
+inline auto operator<=(const LhsUtfStringT& lhs, const RhsUtfStringT& rhs) -> decltype(priv::viewOf(lhs), priv::viewOf(rhs), true) { return priv::compareViews(priv::viewOf(lhs), priv::viewOf(rhs)) <= 0; }
 
 template <class LhsUtfStringT, class RhsUtfStringT>
-inline bool operator==(const LhsUtfStringT& lhs, const RhsUtfStringT& rhs) { return (yutiyeff::Utf32String(lhs)).getSequence() == (yutiyeff::Utf32String(rhs)).getSequence(); }
+inline auto operator>=(const LhsUtfStringT& lhs, const RhsUtfStringT& rhs) -> decltype(priv::viewOf(lhs), priv::viewOf(rhs), true) { return priv::compareViews(priv::viewOf(lhs), priv::viewOf(rhs)) >= 0; }
 
+#ifdef YUTIYEFF_CPP20
 template <class LhsUtfStringT, class RhsUtfStringT>
-inline bool operator!=(const LhsUtfStringT& lhs, const RhsUtfStringT& rhs) { return !(lhs == rhs); }
+inline auto operator<=>(const LhsUtfStringT& lhs, const RhsUtfStringT& rhs) -> decltype(priv::viewOf(lhs), priv::viewOf(rhs), std::strong_ordering(std::strong_ordering::equal)) { return priv::compareViews(priv::viewOf(lhs), priv::viewOf(rhs)) <=> 0; }
+#endif // YUTIYEFF_CPP20
 
 inline bool operator==(const Utf8String& lhs, const Utf8String& rhs) { return lhs.getSequence() == rhs.getSequence(); }
 inline bool operator==(const Utf16String& lhs, const Utf16String& rhs) { return lhs.getSequence() == rhs.getSequence(); }
@@ -831,3 +1068,31 @@ inline Utf16String operator+(const char* lhs, const Utf16String& rhs) { return (
 inline Utf32String operator+(const char* lhs, const Utf32String& rhs) { return (Utf32String{ lhs } + rhs); }
 
 } // namespace yutiyeff
+
+
+
+// HASHING
+// the hash of a string depends only on its code points so strings of different encodings (and views) with the same text have the same hash
+
+namespace std
+{
+
+template <>
+struct hash<yutiyeff::Utf8String>
+{
+	std::size_t operator()(const yutiyeff::Utf8String& string) const { return hash<yutiyeff::Utf8StringView>{}(string.getView()); }
+};
+
+template <>
+struct hash<yutiyeff::Utf16String>
+{
+	std::size_t operator()(const yutiyeff::Utf16String& string) const { return hash<yutiyeff::Utf16StringView>{}(string.getView()); }
+};
+
+template <>
+struct hash<yutiyeff::Utf32String>
+{
+	std::size_t operator()(const yutiyeff::Utf32String& string) const { return hash<yutiyeff::Utf32StringView>{}(string.getView()); }
+};
+
+} // namespace std
@@ -0,0 +1,564 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Yutiyeff (https://github.com/Hapaxia/Yutiyeff)
+//
+// Copyright(c) 2023-2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+
+// Yutiyeff benchmark
+//
+// measures every conversion when constructing (and assigning to) the string types and their operations (length, operator[], find, substr, insert, erase, set,
+// getString and getNonUnicodeString) on several corpora at several sizes. each result is a line of CSV (or JSON) with the time per operation,
+// the time per code point of the corpus and the bytes (and number of) allocations per operation.
+//
+// usage: YutiyeffBenchmark [--format csv|json] [--sizes 100,10000,...] [--corpora ascii,latin1,cjk,emoji,mixed] [--min-time-ms 20] [--kernel scalar|sse42|avx2|avx512]
+
+#include <Yutiyeff.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+// every allocation (by the library or by the benchmark) is counted so the allocations of an operation are the difference around it
+namespace
+{
+
+std::atomic<std::size_t> allocatedBytes{ 0u };
+std::atomic<std::size_t> allocationCount{ 0u };
+
+} // namespace
+
+// GCC sees the "free" (once these are inlined) but not that this "new" is what allocated with "malloc"
+#if defined(__GNUC__) && !defined(__clang__) && (__GNUC__ >= 11)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif // __GNUC__
+
+void* operator new(const std::size_t size)
+{
+	allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+	allocationCount.fetch_add(1u, std::memory_order_relaxed);
+	if (void* const memory{ std::malloc((size != 0u) ? size : 1u) })
+		return memory;
+	throw std::bad_alloc();
+}
+
+void* operator new[](const std::size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void* const memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete[](void* const memory) noexcept
+{
+	operator delete(memory);
+}
+
+void operator delete(void* const memory, std::size_t) noexcept
+{
+	operator delete(memory);
+}
+
+void operator delete[](void* const memory, std::size_t) noexcept
+{
+	operator delete(memory);
+}
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+struct Settings
+{
+	bool isJson{ false };
+	std::vector<std::size_t> sizes{ 100u, 10000u, 1000000u };
+	std::vector<std::string> corpora{ "ascii", "latin1", "cjk", "emoji", "mixed" };
+	double minTimeNs{ 20e6 };
+};
+
+struct Result
+{
+	std::size_t iterations;
+	double nsPerOperation;
+	double bytesPerOperation;
+	double allocationsPerOperation;
+};
+
+// the results of the operations are added into this so that they can't be optimised away
+volatile std::size_t sink{ 0u };
+
+void keep(const std::size_t value)
+{
+	sink = sink + value;
+}
+
+class Random
+{
+public:
+	explicit Random(const std::uint32_t seed) : m_state{ seed } { }
+	std::uint32_t operator()()
+	{
+		// xorshift
+		m_state ^= m_state << 13u;
+		m_state ^= m_state >> 17u;
+		m_state ^= m_state << 5u;
+		return m_state;
+	}
+	std::uint32_t operator()(const std::uint32_t count) { return (*this)() % count; }
+
+private:
+	std::uint32_t m_state;
+};
+
+
+
+// CORPORA
+
+char32_t asciiLetter(Random& random)
+{
+	return U'a' + random(26u);
+}
+
+char32_t latin1Letter(Random& random)
+{
+	// about a quarter of the letters are accented (from the Latin-1 supplement), as in French or German text
+	if (random(4u) != 0u)
+		return asciiLetter(random);
+	const char32_t letter{ static_cast<char32_t>(0xC0u + random(0x40u)) };
+	return ((letter == 0xD7u) || (letter == 0xF7u)) ? U'e' : letter; // not the multiplication or division signs
+}
+
+char32_t cjkLetter(Random& random)
+{
+	// mostly ideographs with some kana
+	return (random(5u) != 0u) ? static_cast<char32_t>(0x4E00u + random(0x5200u)) : static_cast<char32_t>(0x3041u + random(0x5Au));
+}
+
+char32_t emojiLetter(Random& random)
+{
+	return (random(2u) != 0u) ? static_cast<char32_t>(0x1F300u + random(0x350u)) : static_cast<char32_t>(0x1F900u + random(0x100u));
+}
+
+// a text of "length" code points made of "words" (of letters from the corpus) separated by spaces and punctuation
+std::u32string makeCorpus(const std::string& corpus, const std::size_t length)
+{
+	Random random{ 0x9E3779B9u };
+	std::u32string text;
+	text.reserve(length);
+	while (text.size() < length)
+	{
+		std::string script{ corpus };
+		if (corpus == "mixed")
+		{
+			static const char* const scripts[]{ "ascii", "latin1", "cjk", "emoji" };
+			script = scripts[random(4u)];
+		}
+		const std::size_t wordLength{ 1u + random((script == "cjk") ? 4u : (script == "emoji") ? 2u : 9u) };
+		for (std::size_t i{ 0u }; (i < wordLength) && (text.size() < length); ++i)
+		{
+			if (script == "latin1")
+				text += latin1Letter(random);
+			else if (script == "cjk")
+				text += cjkLetter(random);
+			else if (script == "emoji")
+				text += emojiLetter(random);
+			else
+				text += asciiLetter(random);
+		}
+		if (text.size() < length)
+			text += (random(12u) == 0u) ? U'\n' : (random(8u) == 0u) ? U',' : U' ';
+	}
+	return text;
+}
+
+bool isCorpusName(const std::string& name)
+{
+	return (name == "ascii") || (name == "latin1") || (name == "cjk") || (name == "emoji") || (name == "mixed");
+}
+
+
+
+// MEASURING
+
+// runs "run" (which does "count" operations) in batches that double in size until the total time is at least the minimum time.
+// "prepare" is called (untimed) before each batch and "maxBatch" limits a batch (for operations that use up what they were prepared with)
+template <class Prepare, class Run>
+Result measure(const Settings& settings, Prepare prepare, Run run, const std::size_t maxBatch = static_cast<std::size_t>(-1))
+{
+	prepare();
+	run(1u); // warm up
+	double totalNs{ 0.0 };
+	std::size_t totalBytes{ 0u };
+	std::size_t totalAllocations{ 0u };
+	std::size_t iterations{ 0u };
+	std::size_t batch{ 1u };
+	while (totalNs < settings.minTimeNs)
+	{
+		const std::size_t count{ std::min(batch, maxBatch) };
+		prepare();
+		const std::size_t bytesBefore{ allocatedBytes.load(std::memory_order_relaxed) };
+		const std::size_t allocationsBefore{ allocationCount.load(std::memory_order_relaxed) };
+		const Clock::time_point start{ Clock::now() };
+		run(count);
+		const Clock::time_point finish{ Clock::now() };
+		totalBytes += allocatedBytes.load(std::memory_order_relaxed) - bytesBefore;
+		totalAllocations += allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+		totalNs += std::chrono::duration<double, std::nano>(finish - start).count();
+		iterations += count;
+		batch *= 2u;
+	}
+	const double perIteration{ 1.0 / static_cast<double>(iterations) };
+	return Result{ iterations, totalNs * perIteration, static_cast<double>(totalBytes) * perIteration, static_cast<double>(totalAllocations) * perIteration };
+}
+
+template <class Run>
+Result measure(const Settings& settings, Run run)
+{
+	return measure(settings, [] { }, run);
+}
+
+const char* kernelName(const yy::Kernel kernel)
+{
+	switch (kernel)
+	{
+	case yy::Kernel::Scalar:
+		return "scalar";
+	case yy::Kernel::Sse42:
+		return "sse42";
+	case yy::Kernel::Avx2:
+		return "avx2";
+	case yy::Kernel::Avx512:
+		return "avx512";
+	default:
+		return "automatic";
+	}
+}
+
+void printHeader(const Settings& settings)
+{
+	if (settings.isJson)
+		std::printf("[\n");
+	else
+		std::printf("kernel,corpus,codePoints,type,operation,iterations,nsPerOperation,nsPerCodePoint,bytesPerOperation,allocationsPerOperation\n");
+}
+
+void printFooter(const Settings& settings)
+{
+	if (settings.isJson)
+		std::printf("\n]\n");
+}
+
+void printResult(const Settings& settings, const std::string& corpus, const std::size_t codePoints, const char* const type, const char* const operation, const Result& result)
+{
+	static bool isFirst{ true };
+	const double nsPerCodePoint{ result.nsPerOperation / static_cast<double>(std::max<std::size_t>(codePoints, 1u)) };
+	if (settings.isJson)
+	{
+		std::printf("%s  {\"kernel\": \"%s\", \"corpus\": \"%s\", \"codePoints\": %zu, \"type\": \"%s\", \"operation\": \"%s\", \"iterations\": %zu, "
+			"\"nsPerOperation\": %.3f, \"nsPerCodePoint\": %.6f, \"bytesPerOperation\": %.1f, \"allocationsPerOperation\": %.3f}",
+			isFirst ? "" : ",\n", kernelName(yy::getKernel()), corpus.c_str(), codePoints, type, operation, result.iterations,
+			result.nsPerOperation, nsPerCodePoint, result.bytesPerOperation, result.allocationsPerOperation);
+	}
+	else
+	{
+		std::printf("%s,%s,%zu,%s,%s,%zu,%.3f,%.6f,%.1f,%.3f\n", kernelName(yy::getKernel()), corpus.c_str(), codePoints, type, operation, result.iterations,
+			result.nsPerOperation, nsPerCodePoint, result.bytesPerOperation, result.allocationsPerOperation);
+	}
+	std::fflush(stdout);
+	isFirst = false;
+}
+
+
+
+// BENCHMARKS
+
+// the corpus in every form that a string can be constructed from
+struct Sources
+{
+	std::string utf8Sequence;
+	std::u16string utf16Sequence;
+	std::u32string utf32Sequence;
+	yy::Utf8String utf8String;
+	yy::Utf16String utf16String;
+	yy::Utf32String utf32String;
+};
+
+template <class T>
+struct TypeName;
+
+template <>
+struct TypeName<yy::Utf8String>
+{
+	static const char* get() { return "Utf8String"; }
+};
+
+template <>
+struct TypeName<yy::Utf16String>
+{
+	static const char* get() { return "Utf16String"; }
+};
+
+template <>
+struct TypeName<yy::Utf32String>
+{
+	static const char* get() { return "Utf32String"; }
+};
+
+template <class T, class Source>
+void benchmarkConstruction(const Settings& settings, const std::string& corpus, const std::size_t codePoints, const char* const operation, const Source& source)
+{
+	printResult(settings, corpus, codePoints, TypeName<T>::get(), operation, measure(settings, [&](const std::size_t count)
+	{
+		for (std::size_t i{ 0u }; i < count; ++i)
+		{
+			const T string(source);
+			keep(string.getView().getDataSize());
+		}
+	}));
+}
+
+template <class T, class Source>
+void benchmarkAssignment(const Settings& settings, const std::string& corpus, const std::size_t codePoints, const char* const operation, const Source& source)
+{
+	// the same string is assigned to each time so only the first assignment can allocate
+	T string;
+	printResult(settings, corpus, codePoints, TypeName<T>::get(), operation, measure(settings, [&](const std::size_t count)
+	{
+		for (std::size_t i{ 0u }; i < count; ++i)
+		{
+			string.assign(source);
+			keep(string.getView().getDataSize());
+		}
+	}));
+}
+
+template <class T>
+void benchmarkType(const Settings& settings, const std::string& corpus, const Sources& sources)
+{
+	const std::size_t codePoints{ sources.utf32Sequence.size() };
+	const char* const type{ TypeName<T>::get() };
+
+	benchmarkConstruction<T>(settings, corpus, codePoints, "construct from const char*", sources.utf8Sequence.c_str());
+	benchmarkConstruction<T>(settings, corpus, codePoints, "construct from const char16_t*", sources.utf16Sequence.c_str());
+	benchmarkConstruction<T>(settings, corpus, codePoints, "construct from const char32_t*", sources.utf32Sequence.c_str());
+#ifdef YUTIYEFF_CPP20
+	const std::u8string utf8Sequence(sources.utf8Sequence.begin(), sources.utf8Sequence.end());
+	benchmarkConstruction<T>(settings, corpus, codePoints, "construct from const char8_t*", utf8Sequence.c_str());
+	benchmarkConstruction<T>(settings, corpus, codePoints, "construct from std::u8string", utf8Sequence);
+#endif // YUTIYEFF_CPP20
+	benchmarkConstruction<T>(settings, corpus, codePoints, "construct from std::string", sources.utf8Sequence);
+	benchmarkConstruction<T>(settings, corpus, codePoints, "construct from std::u16string", sources.utf16Sequence);
+	benchmarkConstruction<T>(settings, corpus, codePoints, "construct from std::u32string", sources.utf32Sequence);
+	benchmarkConstruction<T>(settings, corpus, codePoints, "construct from Utf8String", sources.utf8String);
+	benchmarkConstruction<T>(settings, corpus, codePoints, "construct from Utf16String", sources.utf16String);
+	benchmarkConstruction<T>(settings, corpus, codePoints, "construct from Utf32String", sources.utf32String);
+	benchmarkConstruction<T>(settings, corpus, codePoints, "construct from Utf8StringView", yy::Utf8StringView(sources.utf8Sequence));
+	benchmarkConstruction<T>(settings, corpus, codePoints, "construct from Utf16StringView", yy::Utf16StringView(sources.utf16Sequence));
+	benchmarkConstruction<T>(settings, corpus, codePoints, "construct from Utf32StringView", yy::Utf32StringView(sources.utf32Sequence));
+	benchmarkAssignment<T>(settings, corpus, codePoints, "assign from Utf8String", sources.utf8String);
+	benchmarkAssignment<T>(settings, corpus, codePoints, "assign from Utf16String", sources.utf16String);
+	benchmarkAssignment<T>(settings, corpus, codePoints, "assign from Utf32String", sources.utf32String);
+
+	const T string(sources.utf32String);
+	if (codePoints == 0u)
+		return;
+
+	// the same "random" positions for every type
+	std::vector<std::size_t> positions(1024u);
+	Random random{ 12345u };
+	for (std::size_t& position : positions)
+		position = random(static_cast<std::uint32_t>(codePoints));
+
+	printResult(settings, corpus, codePoints, type, "length", measure(settings, [&](const std::size_t count)
+	{
+		for (std::size_t i{ 0u }; i < count; ++i)
+			keep(string.length());
+	}));
+
+	printResult(settings, corpus, codePoints, type, "operator[]", measure(settings, [&](const std::size_t count)
+	{
+		for (std::size_t i{ 0u }; i < count; ++i)
+			keep(string[positions[i % positions.size()]]);
+	}));
+
+	// the needle is the end of the text so the whole text is searched
+	const std::size_t needleLength{ std::min<std::size_t>(codePoints, 8u) };
+	const T needle{ string.substr(needleLength, codePoints - needleLength) };
+	printResult(settings, corpus, codePoints, type, "find", measure(settings, [&](const std::size_t count)
+	{
+		for (std::size_t i{ 0u }; i < count; ++i)
+			keep(string.find(needle, 0u));
+	}));
+
+	printResult(settings, corpus, codePoints, type, "substr", measure(settings, [&](const std::size_t count)
+	{
+		for (std::size_t i{ 0u }; i < count; ++i)
+			keep(string.substr(codePoints / 2u, codePoints / 4u).getView().getDataSize());
+	}));
+
+	// the edits change a copy, which is made again (untimed) before each batch
+	T edited;
+	const T insertion{ sources.utf32String.substr(std::min<std::size_t>(codePoints, 4u), 0u) };
+	printResult(settings, corpus, codePoints, type, "insert", measure(settings, [&] { edited = string; }, [&](const std::size_t count)
+	{
+		for (std::size_t i{ 0u }; i < count; ++i)
+			edited.insert(positions[i % positions.size()], insertion);
+		keep(edited.getView().getDataSize());
+	}, std::max<std::size_t>(codePoints / 4u, 1u)));
+
+	printResult(settings, corpus, codePoints, type, "insert code point", measure(settings, [&] { edited = string; }, [&](const std::size_t count)
+	{
+		for (std::size_t i{ 0u }; i < count; ++i)
+			edited.insert(positions[i % positions.size()], string[positions[(i + 1u) % positions.size()]]);
+		keep(edited.getView().getDataSize());
+	}, std::max<std::size_t>(codePoints / 4u, 1u)));
+
+	// erases are at positions within the first half so the copy is never too short
+	printResult(settings, corpus, codePoints, type, "erase", measure(settings, [&] { edited = string; }, [&](const std::size_t count)
+	{
+		for (std::size_t i{ 0u }; i < count; ++i)
+			edited.erase(positions[i % positions.size()] / 2u, 1u);
+		keep(edited.getView().getDataSize());
+	}, std::max<std::size_t>(codePoints / 2u, 1u)));
+
+	printResult(settings, corpus, codePoints, type, "set", measure(settings, [&] { edited = string; }, [&](const std::size_t count)
+	{
+		for (std::size_t i{ 0u }; i < count; ++i)
+			edited.set(positions[i % positions.size()], string[positions[(i + 1u) % positions.size()]]);
+		keep(edited.getView().getDataSize());
+	}));
+
+	printResult(settings, corpus, codePoints, type, "getString", measure(settings, [&](const std::size_t count)
+	{
+		for (std::size_t i{ 0u }; i < count; ++i)
+			keep(string.getString().size());
+	}));
+
+	printResult(settings, corpus, codePoints, type, "getNonUnicodeString", measure(settings, [&](const std::size_t count)
+	{
+		for (std::size_t i{ 0u }; i < count; ++i)
+			keep(string.getNonUnicodeString().size());
+	}));
+}
+
+std::vector<std::string> splitList(const std::string& list)
+{
+	std::vector<std::string> items;
+	std::size_t start{ 0u };
+	while (start <= list.size())
+	{
+		std::size_t comma{ list.find(',', start) };
+		if (comma == std::string::npos)
+			comma = list.size();
+		if (comma != start)
+			items.push_back(list.substr(start, comma - start));
+		start = comma + 1u;
+	}
+	return items;
+}
+
+int usage(const char* const program)
+{
+	std::fprintf(stderr, "usage: %s [--format csv|json] [--sizes 100,10000,...] [--corpora ascii,latin1,cjk,emoji,mixed] [--min-time-ms 20] "
+		"[--kernel scalar|sse42|avx2|avx512]\n", program);
+	return 1;
+}
+
+} // namespace
+
+int main(const int argc, char** const argv)
+{
+	Settings settings;
+	for (int i{ 1 }; i < argc; ++i)
+	{
+		const std::string argument{ argv[i] };
+		if (i + 1 == argc)
+			return usage(argv[0]);
+		const std::string value{ argv[++i] };
+		if (argument == "--format")
+		{
+			if ((value != "csv") && (value != "json"))
+				return usage(argv[0]);
+			settings.isJson = (value == "json");
+		}
+		else if (argument == "--sizes")
+		{
+			settings.sizes.clear();
+			for (const std::string& size : splitList(value))
+				settings.sizes.push_back(static_cast<std::size_t>(std::strtoull(size.c_str(), nullptr, 10)));
+		}
+		else if (argument == "--corpora")
+		{
+			settings.corpora = splitList(value);
+			for (const std::string& corpus : settings.corpora)
+			{
+				if (!isCorpusName(corpus))
+					return usage(argv[0]);
+			}
+		}
+		else if (argument == "--min-time-ms")
+			settings.minTimeNs = std::strtod(value.c_str(), nullptr) * 1e6;
+		else if (argument == "--kernel")
+		{
+			const yy::Kernel kernel{ (value == "scalar") ? yy::Kernel::Scalar : (value == "sse42") ? yy::Kernel::Sse42 : (value == "avx2") ? yy::Kernel::Avx2 : (value == "avx512") ? yy::Kernel::Avx512 : yy::Kernel::Automatic };
+			if ((kernel == yy::Kernel::Automatic) || !yy::setKernel(kernel))
+			{
+				std::fprintf(stderr, "kernel \"%s\" is not supported\n", value.c_str());
+				return 1;
+			}
+		}
+		else
+			return usage(argv[0]);
+	}
+
+	printHeader(settings);
+	for (const std::string& corpus : settings.corpora)
+	{
+		for (const std::size_t size : settings.sizes)
+		{
+			const std::u32string text{ makeCorpus(corpus, size) };
+			const yy::Utf32String utf32String{ text };
+			const Sources sources{ utf32String.getString(), yy::Utf16String(utf32String).getSequence(), text, yy::Utf8String(utf32String), yy::Utf16String(utf32String), utf32String };
+			benchmarkType<yy::Utf8String>(settings, corpus, sources);
+			benchmarkType<yy::Utf16String>(settings, corpus, sources);
+			benchmarkType<yy::Utf32String>(settings, corpus, sources);
+		}
+	}
+	printFooter(settings);
+	return 0;
+}
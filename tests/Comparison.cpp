@@ -0,0 +1,183 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Yutiyeff (https://github.com/Hapaxia/Yutiyeff)
+//
+// Copyright(c) 2023-2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+
+
+// Yutiyeff comparison test
+//
+// checks that invalid sequences (overlong, surrogate and truncated or out of range) compare and hash as they would once they are in a string
+// (each invalid part as one U+FFFD) whatever their encoding, that equality stays transitive across the encodings and that an invalid part
+// never matches the code point it would decode to if it were not rejected (an overlong '/' is not a '/').
+// returns the number of failed checks.
+
+#include <Yutiyeff.hpp>
+#include <functional>
+#include <iostream>
+#include <string>
+
+namespace
+{
+
+int failures{ 0 };
+
+void check(const bool passed, const char* const what, const char* const name)
+{
+	if (passed)
+		return;
+	std::cerr << "FAILED: " << what << " (" << name << ")" << std::endl;
+	++failures;
+}
+
+int sign(const int value)
+{
+	return (value > 0) - (value < 0);
+}
+
+// the sign of a comparison by the standard string of code points
+int expectedOrder(const std::u32string& lhs, const std::u32string& rhs)
+{
+	return sign(lhs.compare(rhs));
+}
+
+template <class LhsT, class RhsT>
+int order(const LhsT& lhs, const RhsT& rhs)
+{
+	return (lhs < rhs) ? -1 : ((lhs > rhs) ? 1 : 0);
+}
+
+template <class T>
+std::size_t hashOf(const T& value)
+{
+	return std::hash<T>{}(value);
+}
+
+// "view" is an invalid sequence, "repaired" is its code points once it is in a string (with U+FFFD for each invalid part)
+// and "lookalike" is the valid text that it would be if the invalid parts were decoded leniently (or dropped)
+template <class CharT>
+void checkInvalid(const char* const name, const std::basic_string<CharT>& sequence, const std::u32string& repaired, const std::u32string& lookalike)
+{
+	const yy::StringView<CharT> view{ sequence };
+	check(!view.isValid(), "the sequence is invalid", name);
+
+	// the same as the repaired text in every encoding (as a string or as a view of the string's sequence)
+	const yy::Utf8String repaired8{ repaired };
+	const yy::Utf16String repaired16{ repaired };
+	const yy::Utf32String repaired32{ repaired };
+	const std::string repaired8Sequence{ repaired8.getSequence() };
+	const std::u16string repaired16Sequence{ repaired16.getSequence() };
+	check(view == repaired8, "equal to the repaired UTF-8 string", name);
+	check(view == repaired16, "equal to the repaired UTF-16 string", name);
+	check(view == repaired32, "equal to the repaired UTF-32 string", name);
+	check(view == yy::Utf8StringView{ repaired8Sequence }, "equal to a view of the repaired UTF-8", name);
+	check(view == yy::Utf16StringView{ repaired16Sequence }, "equal to a view of the repaired UTF-16", name);
+	check(view == yy::Utf32StringView{ repaired }, "equal to a view of the repaired UTF-32", name);
+	check(!(view < repaired16) && !(view > repaired16) && (view <= repaired16) && (view >= repaired16), "ordered the same as the repaired UTF-16", name);
+
+	// and so to the strings that are created from it (which are then equal to each other)
+	const yy::Utf8String string8{ view };
+	const yy::Utf16String string16{ view };
+	const yy::Utf32String string32{ view };
+	check((view == string8) && (view == string16) && (view == string32), "equal to the strings created from it", name);
+	check((string8 == string16) && (string16 == string32) && (string8 == string32), "the strings created from it are equal", name);
+	check((string8 == repaired8) && (string16 == repaired16) && (string32 == repaired32), "the strings created from it are repaired", name);
+
+	// with the same hash as all of them
+	const std::size_t hash{ hashOf(view) };
+	check((hash == hashOf(repaired8)) && (hash == hashOf(repaired16)) && (hash == hashOf(repaired32)), "hashed as the repaired strings", name);
+	check((hash == hashOf(string8)) && (hash == hashOf(string16)) && (hash == hashOf(string32)), "hashed as the strings created from it", name);
+
+	// but not the same as the lookalike (in any encoding) and ordered as the repaired text is
+	const yy::Utf8String lookalike8{ lookalike };
+	const yy::Utf16String lookalike16{ lookalike };
+	const yy::Utf32String lookalike32{ lookalike };
+	check((view != lookalike8) && (view != lookalike16) && (view != lookalike32), "not equal to the lookalike", name);
+	check(hash != hashOf(lookalike32), "not hashed as the lookalike", name);
+	const int expected{ expectedOrder(repaired, lookalike) };
+	check((order(view, lookalike8) == expected) && (order(view, lookalike16) == expected) && (order(view, lookalike32) == expected), "ordered as the repaired text against the lookalike", name);
+	check((order(lookalike8, view) == -expected) && (order(lookalike16, view) == -expected) && (order(lookalike32, view) == -expected), "ordered as the repaired text against the lookalike (reversed)", name);
+}
+
+// two different invalid sequences in the same encoding that are the same once they are in a string
+template <class CharT>
+void checkSameOnceRepaired(const char* const name, const std::basic_string<CharT>& lhsSequence, const std::basic_string<CharT>& rhsSequence)
+{
+	const yy::StringView<CharT> lhs{ lhsSequence };
+	const yy::StringView<CharT> rhs{ rhsSequence };
+	check((lhs == rhs) && !(lhs != rhs) && !(lhs < rhs) && !(lhs > rhs), "equal", name);
+	check(hashOf(lhs) == hashOf(rhs), "hashed the same", name);
+}
+
+// two different invalid sequences in the same encoding that are different once they are in a string
+template <class CharT>
+void checkDifferentOnceRepaired(const char* const name, const std::basic_string<CharT>& lhsSequence, const std::basic_string<CharT>& rhsSequence, const int expected)
+{
+	const yy::StringView<CharT> lhs{ lhsSequence };
+	const yy::StringView<CharT> rhs{ rhsSequence };
+	check((lhs != rhs) && (order(lhs, rhs) == expected) && (order(rhs, lhs) == -expected), "ordered", name);
+}
+
+} // namespace
+
+int main()
+{
+	const char32_t r{ 0xFFFD };
+
+	// overlong: '/' as two bytes is two invalid parts (0xC0 can never start a sequence)
+	checkInvalid<char>("UTF-8 overlong", "..\xC0\xAF" "etc", { '.', '.', r, r, 'e', 't', 'c' }, U"../etc");
+	checkInvalid<char>("UTF-8 overlong (three bytes)", "a\xE0\x80\xAF" "b", { 'a', r, r, r, 'b' }, U"a/b");
+
+	// surrogates: encoded in UTF-8 (0xED then a byte that is out of range for it) or unpaired in UTF-16 and UTF-32
+	checkInvalid<char>("UTF-8 surrogate", "a\xED\xA0\x80" "b", { 'a', r, r, r, 'b' }, U"ab");
+	checkInvalid<char16_t>("UTF-16 high surrogate", { 'a', 0xD800, 'b' }, { 'a', r, 'b' }, U"ab");
+	checkInvalid<char16_t>("UTF-16 low surrogate", { 'a', 0xDC00, 0xDC00, 'b' }, { 'a', r, r, 'b' }, { 'a', 0x10000, 'b' });
+	checkInvalid<char16_t>("UTF-16 reversed surrogates", { 0xDE00, 0xD83D, 'x' }, { r, r, 'x' }, { 0x1F600, 'x' });
+	checkInvalid<char32_t>("UTF-32 surrogate", { 'a', 0xD800, 'b' }, { 'a', r, 'b' }, U"ab");
+
+	// truncated (a single invalid part however many of its code units are there) or, in UTF-32, out of range
+	checkInvalid<char>("UTF-8 truncated", "a\xE2\x82", { 'a', r }, U"a\u20AC");
+	checkInvalid<char>("UTF-8 truncated (four bytes)", "\xF0\x9F\x98" "a", { r, 'a' }, U"\U0001F600a");
+	checkInvalid<char16_t>("UTF-16 truncated", { 'a', 0xD83D }, { 'a', r }, U"a\U0001F600");
+	checkInvalid<char32_t>("UTF-32 out of range", { 'a', 0x110000 }, { 'a', r }, U"a\U0010FFFF");
+
+	// different invalid parts are all U+FFFD so they match each other (and a real U+FFFD) but a different number of them does not
+	checkSameOnceRepaired<char>("UTF-8 invalid parts", "x\xC0y", "x\xFFy");
+	checkSameOnceRepaired<char>("UTF-8 truncated parts", "x\xE2\x82y", "x\xF0\x9F\x98y");
+	checkSameOnceRepaired<char>("UTF-8 replacement character", "x\xC1y", "x\xEF\xBF\xBDy");
+	checkSameOnceRepaired<char16_t>("UTF-16 surrogates", { 'x', 0xD800, 'y' }, { 'x', 0xDFFF, 'y' });
+	checkSameOnceRepaired<char16_t>("UTF-16 replacement character", { 'x', 0xDBFF }, { 'x', 0xFFFD });
+	checkSameOnceRepaired<char32_t>("UTF-32 invalid code points", { 'x', 0xD800, 'y' }, { 'x', 0x7FFFFFFF, 'y' });
+	checkDifferentOnceRepaired<char>("UTF-8 number of invalid parts", "x\xC0\xAFy", "x\xE2\x82y", 1);
+	checkDifferentOnceRepaired<char>("UTF-8 invalid part before the end", "x\xE2\x82", "x\xE2\x82\xAC", 1);
+	checkDifferentOnceRepaired<char16_t>("UTF-16 invalid part after a code point above 0xFFFF", { 0xD83D, 0xDE00, 0xD800 }, { 0xD83D, 0xDE00, 0xFFFF }, -1);
+
+	if (failures == 0)
+		std::cout << "all comparisons passed" << std::endl;
+	return failures;
+}